@@ -8,6 +8,7 @@
 
 package com.gaurav.avnc.ui.vnc
 
+import android.graphics.Rect
 import org.junit.Assert.assertEquals
 import org.junit.Assert.assertTrue
 import org.junit.Test
@@ -262,4 +263,18 @@ class FrameStateTest {
         state.updateZoom(2f)   // Increased too much,
         assertTrue(state.zoomScale > 1)  // should no longer be snapped
     }
+
+    @Test
+    fun visibleFbRectTest() {
+        val state = FrameState()
+        state.setWindowSize(100f, 100f)
+        state.setViewportSize(100f, 100f)
+        state.setFramebufferSize(100f, 100f)
+        assertEquals(Rect(0, 0, 100, 100), state.getVisibleFbRect())
+
+        state.updateZoom(2F) // Only a quarter of framebuffer should be visible
+        val rect = state.getVisibleFbRect()
+        assertEquals(50, rect.width())
+        assertEquals(50, rect.height())
+    }
 }
\ No newline at end of file
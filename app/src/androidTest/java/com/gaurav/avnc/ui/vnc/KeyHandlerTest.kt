@@ -17,6 +17,8 @@ import com.gaurav.avnc.instrumentation
 import com.gaurav.avnc.targetContext
 import com.gaurav.avnc.util.AppPreferences
 import com.gaurav.avnc.vnc.XKeySym
+import com.gaurav.avnc.vnc.XKeySymAndroid
+import com.gaurav.avnc.vnc.XTKeyCode
 import io.mockk.every
 import io.mockk.mockk
 import org.junit.After
@@ -57,6 +59,14 @@ class KeyHandlerTest {
             dispatchedXTUps.add(secondArg())
             true
         }
+
+        // Translates with the same native tables VncClient uses, so they are exercised by these tests too.
+        // Native tables themselves are verified against reference tables in NativeKeyTablesTest.
+        every { mockDispatcher.onAndroidKey(any(), any(), any()) } answers {
+            val keySym = XKeySymAndroid.getKeySymForAndroidKeyCode(firstArg())
+            val xtCode = XTKeyCode.fromAndroidScancode(secondArg())
+            mockDispatcher.onXKey(keySym, xtCode, thirdArg())
+        }
         keyHandler = KeyHandler(mockDispatcher, true, prefs)
     }
 
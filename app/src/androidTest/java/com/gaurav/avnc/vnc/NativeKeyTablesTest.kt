@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+package com.gaurav.avnc.vnc
+
+import android.view.KeyEvent
+import org.junit.Assert.assertEquals
+import org.junit.Test
+import com.gaurav.avnc.vnc.reference.XKeySymAndroid as RefXKeySymAndroid
+import com.gaurav.avnc.vnc.reference.XKeySymUnicode as RefXKeySymUnicode
+import com.gaurav.avnc.vnc.reference.XTKeyCode as RefXTKeyCode
+
+/**
+ * Compares native key translation tables (XKeySym.h) against the original
+ * Kotlin tables, for every possible input, including out-of-range ones.
+ */
+class NativeKeyTablesTest {
+
+    @Test
+    fun androidKeyCodes() {
+        for (keyCode in -1..KeyEvent.getMaxKeyCode() + 16) {
+            assertEquals("keyCode: $keyCode",
+                         RefXKeySymAndroid.getKeySymForAndroidKeyCode(keyCode),
+                         XKeySymAndroid.getKeySymForAndroidKeyCode(keyCode))
+        }
+    }
+
+    @Test
+    fun scanCodes() {
+        // Linux keycodes are below 0x300 (KEY_MAX)
+        for (scanCode in -1..0x300) {
+            assertEquals("scanCode: $scanCode",
+                         RefXTKeyCode.fromAndroidScancode(scanCode),
+                         XTKeyCode.fromAndroidScancode(scanCode))
+        }
+    }
+
+    @Test
+    fun legacyUnicodeKeySyms() {
+        for (uChar in 0..Character.MAX_CODE_POINT) {
+            val expected = RefXKeySymUnicode.getLegacyKeySymForUnicodeChar(uChar)
+            val actual = XKeySymUnicode.getLegacyKeySymForUnicodeChar(uChar)
+            if (expected != actual)
+                assertEquals("uChar: $uChar", expected, actual)
+        }
+    }
+
+    @Test
+    fun unicodeKeySyms() {
+        for (uChar in 0..Character.MAX_CODE_POINT) {
+            val expected = RefXKeySymUnicode.getKeySymForUnicodeChar(uChar)
+            val actual = XKeySymUnicode.getKeySymForUnicodeChar(uChar)
+            if (expected != actual)
+                assertEquals("uChar: $uChar", expected, actual)
+        }
+    }
+}
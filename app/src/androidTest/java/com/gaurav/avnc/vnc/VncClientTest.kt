@@ -26,6 +26,8 @@ class VncClientTest {
         override fun onGotXCutText(text: String) {
             cutText = text
         }
+
+        override fun onServerClipboardAvailable() {}
     }
 
 
@@ -83,6 +85,15 @@ class VncClientTest {
         assertEquals(sampleTextWithAccent, observer.cutText)
     }
 
+    @Test
+    fun serverCutTextOverLimit() {
+        connect()
+        client.setMaxCutTextSize(sampleText.length - 1)
+        server.sendCutText(sampleText)
+        client.processServerMessage()
+        assertEquals("", observer.cutText)
+    }
+
     @Test
     fun clientCutText() {
         connect()
@@ -100,4 +111,23 @@ class VncClientTest {
         server.awaitStop()
         assertEquals(sampleTextWithAccent, server.receivedCutText)
     }
+
+    @Test
+    fun clientCutTextOverLimit() {
+        connect()
+        client.setMaxCutTextSize(sampleText.length - 1)
+        client.sendCutText(sampleText)
+        client.cleanup()
+        server.awaitStop()
+        assertEquals("", server.receivedCutText)
+    }
+
+    @Test
+    fun typeText() {
+        connect()
+        client.typeText("aB\r\n", 0)
+        client.cleanup()
+        server.awaitStop()
+        assertEquals(listOf(0x61, 0xffe1, 0x42, 0xff0d), server.receivedKeySyms)
+    }
 }
\ No newline at end of file
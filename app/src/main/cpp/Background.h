@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_BACKGROUND_H
+#define AVNC_BACKGROUND_H
+
+#include <sys/socket.h>
+#include <netinet/tcp.h>
+#include <rfb/rfbclient.h>
+#include "Utility.h"
+
+/**
+ * Handling of sessions which are in background.
+ *
+ * While paused, no framebuffer update requests are sent to the server (see
+ * UpdateScheduler), so it stops sending updates. TCP keepalive is enabled on the socket to keep the
+ * connection alive (e.g. through NATs) without any RFB traffic.
+ *
+ * To report the savings, we track the bytes received on the socket, and use
+ * the average rate of the active period to estimate bytes not received.
+ */
+struct BackgroundState {
+    // Changed by receiver thread (requested via processServerMessage), read
+    // from any thread. Use atomic operations.
+    bool paused;
+
+    // Start of the current period (active or paused)
+    uint64_t periodStartUs;
+    uint64_t periodStartBytes;
+
+    // Average receive rate in last active period, bytes/sec
+    uint64_t activeRate;
+
+    // Protects all of the above, so that period is consistent with paused
+    MUTEX(mutex);
+};
+
+static void initBackgroundState(BackgroundState *state) {
+    INIT_MUTEX(state->mutex);
+    state->paused = false;
+    state->periodStartUs = 0;
+    state->periodStartBytes = 0;
+    state->activeRate = 0;
+}
+
+static void destroyBackgroundState(BackgroundState *state) {
+    TINI_MUTEX(state->mutex);
+}
+
+/**
+ * Returns total number of bytes received on the socket, 0 if not available.
+ */
+static uint64_t getReceivedBytes(rfbClient *client) {
+    tcp_info info{};
+    socklen_t len = sizeof(info);
+    if (getsockopt(client->sock, IPPROTO_TCP, TCP_INFO, &info, &len) != 0)
+        return 0;
+    return info.tcpi_bytes_received;
+}
+
+static void enableKeepAlive(rfbClient *client) {
+    int on = 1, idle = 60, interval = 15, count = 4;
+    setsockopt(client->sock, SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on));
+    setsockopt(client->sock, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle));
+    setsockopt(client->sock, IPPROTO_TCP, TCP_KEEPINTVL, &interval, sizeof(interval));
+    setsockopt(client->sock, IPPROTO_TCP, TCP_KEEPCNT, &count, sizeof(count));
+}
+
+/**
+ * Must be called with state->mutex held.
+ */
+static void startPeriodLocked(rfbClient *client, BackgroundState *state) {
+    state->periodStartUs = monotonicTimeUs();
+    state->periodStartBytes = getReceivedBytes(client);
+}
+
+static void startPeriod(rfbClient *client, BackgroundState *state) {
+    LOCK(state->mutex);
+    startPeriodLocked(client, state);
+    UNLOCK(state->mutex);
+}
+
+/**
+ * Whether updates are paused. Can be called from any thread.
+ */
+static bool isUpdatesPaused(BackgroundState *state) {
+    return __atomic_load_n(&state->paused, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Returns for how long updates have been paused, 0 if they are not paused.
+ * Can be called from any thread.
+ */
+static uint64_t getPausedDurationUs(BackgroundState *state) {
+    LOCK(state->mutex);
+    auto duration = state->paused ? monotonicTimeUs() - state->periodStartUs : 0;
+    UNLOCK(state->mutex);
+    return duration;
+}
+
+/**
+ * Stops framebuffer update requests.
+ */
+static void pauseUpdates(rfbClient *client, BackgroundState *state) {
+    LOCK(state->mutex);
+    if (state->paused) {
+        UNLOCK(state->mutex);
+        return;
+    }
+
+    auto elapsedUs = monotonicTimeUs() - state->periodStartUs;
+    auto bytes = getReceivedBytes(client) - state->periodStartBytes;
+    state->activeRate = (state->periodStartUs && elapsedUs) ? bytes * 1000000 / elapsedUs : 0;
+
+    enableKeepAlive(client);
+    __atomic_store_n(&state->paused, true, __ATOMIC_RELEASE);
+    startPeriodLocked(client, state);
+    UNLOCK(state->mutex);
+}
+
+/**
+ * Restarts framebuffer update requests.
+ */
+static void resumeUpdates(rfbClient *client, BackgroundState *state) {
+    LOCK(state->mutex);
+    if (!state->paused) {
+        UNLOCK(state->mutex);
+        return;
+    }
+
+    auto elapsedUs = monotonicTimeUs() - state->periodStartUs;
+    auto received = getReceivedBytes(client) - state->periodStartBytes;
+    auto expected = state->activeRate * elapsedUs / 1000000;
+    auto saved = expected > received ? expected - received : 0;
+
+    log_info("Updates were paused for %llus, received %llu bytes, saved ~%llu bytes",
+             (unsigned long long) (elapsedUs / 1000000), (unsigned long long) received,
+             (unsigned long long) saved);
+
+    __atomic_store_n(&state->paused, false, __ATOMIC_RELEASE);
+    startPeriodLocked(client, state);
+    UNLOCK(state->mutex);
+}
+
+#endif //AVNC_BACKGROUND_H
@@ -11,6 +11,20 @@
 
 #include <jni.h>
 #include "Cursor.h"
+#include "Scroll.h"
+#include "Resize.h"
+#include "Background.h"
+#include "UpdateScheduler.h"
+#include "UploadPlanner.h"
+#include "FrameTexture.h"
+#include "LazyJpeg.h"
+#include "Downsample.h"
+#include "FrameDetail.h"
+#include "ZlibStreams.h"
+#include "Clipboard.h"
+
+struct H264Decoder;
+struct HibernatedFrameBuffer;
 
 /**
  * We attach some additional data to every rfbClient.
@@ -27,9 +41,72 @@ struct ClientEx {
     int fbRealWidth;
     int fbRealHeight;
 
+    // Framebuffer is stored at server resolution >> fbShift, to keep it
+    // within fbBudget bytes (0 means no limit). See Downsample.h.
+    // fbShift is protected with fbMutex, but only receiver thread modifies it.
+    size_t fbBudget;
+    int fbShift;
+
+    // Used by receiver thread while downsampling incoming rectangles
+    ScratchBuffer fbScratch;
+
+    // Full resolution region of downsampled framebuffer, shown when zoomed in
+    FrameDetail detail;
+
     // Cursor data used for client-side cursor rendering
     Cursor *cursor;
 
+    // New cursor shapes are prepared here by receiver thread, then swapped into cursor
+    ScratchBuffer cursorShape;
+    ScratchBuffer cursorScaled;
+
+    // Whether Open H.264 encoding should be requested from server
+    bool preferH264;
+
+    // Created when first H.264 rectangle is received
+    H264Decoder *h264;
+
+    // Cut text larger than this (in bytes) is dropped. 0 means no limit.
+    int maxCutTextSize;
+
+    // Hash of most recent cut text sent to, or received from, the server.
+    // Used to drop duplicates without involving Java. Accessed from both
+    // sender & receiver threads, so use atomic operations.
+    uint64_t lastCutTextHash;
+
+    // Extended clipboard state, see Clipboard.h
+    ClipboardState clipboard;
+
+    // Pending scroll wheel events
+    ScrollAccumulator scroll;
+
+    // State of remote desktop resize requests
+    ResizeState resize;
+
+    // Pause state of framebuffer updates
+    BackgroundState background;
+
+    // Schedules framebuffer update requests
+    UpdateScheduler scheduler;
+
+    // Damaged parts of framebuffer, yet to be uploaded to texture
+    UploadPlanner uploads;
+
+    // GL upload state, used on renderer thread
+    FrameTexture texture;
+
+    // JPEG rectangles waiting to be decoded
+    LazyJpeg jpeg;
+
+    // Parked zlib streams of LibVNCClient (receiver thread only)
+    ZlibStreams zlibStreams;
+
+    // Compressed framebuffer, while client->frameBuffer is hibernated
+    HibernatedFrameBuffer *hibernated;
+
+    // Pending memory trim request, see MemoryUsage.h. Use atomic operations.
+    int trimRequest;
+
     // Protects modification to framebuffer & cursor
     MUTEX(mutex);
 };
@@ -66,6 +143,27 @@ ClientEx *assignClientExtension(rfbClient *client) {
     if (ex) {
         INIT_MUTEX(ex->mutex);
         ex->cursor = nullptr;
+        ex->cursorShape = {nullptr, 0};
+        ex->cursorScaled = {nullptr, 0};
+        ex->fbBudget = 0;
+        ex->fbShift = 0;
+        ex->fbScratch = {nullptr, 0};
+        initFrameDetail(&ex->detail);
+        ex->preferH264 = false;
+        ex->h264 = nullptr;
+        ex->maxCutTextSize = 0;
+        ex->lastCutTextHash = 0;
+        initClipboard(&ex->clipboard);
+        initScrollAccumulator(&ex->scroll);
+        initResizeState(&ex->resize);
+        initBackgroundState(&ex->background);
+        initUpdateScheduler(&ex->scheduler);
+        initUploadPlanner(&ex->uploads);
+        initFrameTexture(&ex->texture);
+        initLazyJpeg(&ex->jpeg);
+        initZlibStreams(&ex->zlibStreams);
+        ex->hibernated = nullptr;
+        ex->trimRequest = 0;
         setClientExtension(client, ex);
     }
     return ex;
@@ -78,7 +176,20 @@ void freeClientExtension(rfbClient *client) {
     auto ex = getClientExtension(client);
     if (ex) {
         TINI_MUTEX(ex->mutex);
+        destroyScrollAccumulator(&ex->scroll);
+        destroyClipboard(&ex->clipboard);
+        destroyResizeState(&ex->resize);
+        destroyBackgroundState(&ex->background);
+        logUpdateSchedulerStats(&ex->scheduler);
+        destroyUploadPlanner(&ex->uploads);
+        logFrameTextureStats(&ex->texture);
+        destroyLazyJpeg(&ex->jpeg);
+        destroyZlibStreams(&ex->zlibStreams);
         freeCursor(ex->cursor);
+        freeScratch(&ex->cursorShape);
+        freeScratch(&ex->cursorScaled);
+        freeScratch(&ex->fbScratch);
+        destroyFrameDetail(&ex->detail);
         free(ex);
         setClientExtension(client, nullptr);
     }
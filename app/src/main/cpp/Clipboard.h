@@ -0,0 +1,430 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_CLIPBOARD_H
+#define AVNC_CLIPBOARD_H
+
+#include <zlib.h>
+#include <rfb/rfbclient.h>
+#include "Utility.h"
+
+/**
+ * Extended clipboard, with lazy transfers.
+ *
+ * LibVNCClient only implements the eager part of extended clipboard: every
+ * change is sent in full (Provide), and server's text is inflated completely
+ * into memory on receiver thread. With large clips, that stalls the connection
+ * for every copy, even if the text is never pasted on the other side.
+ *
+ * So ServerCutText messages are handled here, before they reach LibVNCClient,
+ * and the notify/request/provide flow is used instead:
+ *
+ *  - Local copy: text is stored here, and only a Notify is sent. Text is
+ *    compressed & sent when server Requests it (i.e. when something is pasted
+ *    on the server).
+ *  - Remote copy: server sends a Notify, which is passed on to Java. Text is
+ *    Requested only when the app is likely to paste it elsewhere (it loses focus).
+ *    The Provide is then inflated incrementally, and dropped as soon as it
+ *    exceeds the size limit.
+ *
+ * Servers without Notify support get the old eager transfers. Legacy (Latin-1)
+ * cut text is also read here, so that over-limit text is skipped without
+ * allocating for it.
+ *
+ * Message format: ClientCutText/ServerCutText with negative length, followed
+ * by a 32-bit flags word (action bits 24-31, format bits 0-15).
+ */
+
+const uint32_t ClipboardFormatText = 1 << 0;
+const uint32_t ClipboardFormatMask = 0xFFFF;
+const uint32_t ClipboardActionCaps = 1 << 24;
+const uint32_t ClipboardActionRequest = 1 << 25;
+const uint32_t ClipboardActionPeek = 1 << 26;
+const uint32_t ClipboardActionNotify = 1 << 27;
+const uint32_t ClipboardActionProvide = 1 << 28;
+
+const uint8_t ServerCutTextType = 3;
+const uint8_t ClientCutTextType = 6;
+
+// Compressed data is read from socket in chunks of this size
+const uint32_t ClipboardReadChunk = 16 * 1024;
+
+struct ClipboardState {
+    // Text announced to server, waiting for a Request (UTF-8, without terminator).
+    // Set by sender thread, read by receiver thread, protected by mutex.
+    char *localText;
+    int localLength;
+
+    // Whether server has announced text we haven't fetched yet. Use atomic operations.
+    bool serverHasText;
+
+    // Called on receiver thread when serverHasText becomes true
+    void (*onServerTextAvailable)(rfbClient *client);
+
+    // Stats
+    int notifySent;
+    int provideSent;
+    int requestSent;
+    int provideReceived;
+    int provideDropped;
+
+    MUTEX(mutex);
+};
+
+static void initClipboard(ClipboardState *cb) {
+    INIT_MUTEX(cb->mutex);
+    cb->localText = nullptr;
+    cb->localLength = 0;
+    cb->serverHasText = false;
+    cb->onServerTextAvailable = nullptr;
+    cb->notifySent = cb->provideSent = cb->requestSent = 0;
+    cb->provideReceived = cb->provideDropped = 0;
+}
+
+static void destroyClipboard(ClipboardState *cb) {
+    if (cb->notifySent || cb->requestSent)
+        log_info("Clipboard: %d notified, %d provided, %d requested, %d received, %d dropped",
+                 cb->notifySent, cb->provideSent, cb->requestSent, cb->provideReceived, cb->provideDropped);
+    free(cb->localText);
+    cb->localText = nullptr;
+    TINI_MUTEX(cb->mutex);
+}
+
+/**
+ * Whether server accepts given action from us.
+ */
+static bool serverSupportsClipboardAction(rfbClient *client, uint32_t action) {
+    return (client->extendedClipboardServerCapabilities & action) != 0;
+}
+
+static void putU32BE(uint8_t *p, uint32_t v) {
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+/**
+ * Sends extended ClientCutText message.
+ * [buffer] must have 12 bytes reserved in front of [payloadLength] bytes of payload,
+ * so the whole message is written at once (other threads also write to the socket).
+ */
+static rfbBool sendExtendedClipboard(rfbClient *client, uint8_t *buffer, uint32_t flags, uint32_t payloadLength) {
+    buffer[0] = ClientCutTextType;
+    buffer[1] = buffer[2] = buffer[3] = 0;
+    putU32BE(buffer + 4, (uint32_t) -(int32_t) (4 + payloadLength));
+    putU32BE(buffer + 8, flags);
+    return WriteToRFBServer(client, (const char *) buffer, 12 + payloadLength);
+}
+
+static rfbBool sendClipboardFlags(rfbClient *client, uint32_t flags) {
+    uint8_t buffer[12];
+    return sendExtendedClipboard(client, buffer, flags, 0);
+}
+
+/**
+ * Sends our capabilities, in reply to server's.
+ * If server can notify us, unsolicited text is refused (max size 0), so that
+ * everything goes through Notify/Request.
+ */
+static rfbBool sendClipboardCaps(rfbClient *client, int maxSize) {
+    uint8_t buffer[12 + 4];
+    uint32_t unsolicited = maxSize > 0 ? maxSize : UINT32_MAX;
+    if (serverSupportsClipboardAction(client, ClipboardActionNotify))
+        unsolicited = 0;
+
+    auto flags = ClipboardActionCaps | ClipboardActionRequest | ClipboardActionPeek |
+                 ClipboardActionNotify | ClipboardActionProvide | ClipboardFormatText;
+    putU32BE(buffer + 12, unsolicited);
+    return sendExtendedClipboard(client, buffer, flags, 4);
+}
+
+/**
+ * Compresses & sends stored local text. If there is none, an empty Provide is
+ * sent, telling server that the text is no longer available.
+ */
+static rfbBool sendClipboardProvide(rfbClient *client, ClipboardState *cb) {
+    LOCK(cb->mutex);
+    auto length = cb->localText ? (uLong) cb->localLength + 1 : 0; // +1 for terminator
+
+    // Uncompressed: [size][text + NUL], compressed as a standalone zlib stream
+    auto rawLength = length ? 4 + length : 0;
+    auto bound = compressBound(rawLength);
+    auto raw = (uint8_t *) malloc(rawLength + 12 + bound);
+    if (!raw) {
+        UNLOCK(cb->mutex);
+        rfbClientErr("Clipboard: Could not allocate %lu bytes\n", (unsigned long) (rawLength + 12 + bound));
+        return FALSE;
+    }
+    if (length) {
+        putU32BE(raw, length);
+        memcpy(raw + 4, cb->localText, length - 1);
+        raw[rawLength - 1] = 0;
+    }
+    UNLOCK(cb->mutex);
+
+    auto message = raw + rawLength;
+    auto compressedLength = bound;
+    if (compress(message + 12, &compressedLength, raw, rawLength) != Z_OK) {
+        free(raw);
+        rfbClientErr("Clipboard: Compression failed\n");
+        return FALSE;
+    }
+
+    auto flags = ClipboardActionProvide | (length ? ClipboardFormatText : 0);
+    auto result = sendExtendedClipboard(client, message, flags, compressedLength);
+    free(raw);
+    if (result && length)
+        ++cb->provideSent;
+    return result;
+}
+
+/**
+ * Stores [text] as local clipboard & announces it to the server.
+ * Returns false if server doesn't support lazy transfers; caller should then
+ * send the text eagerly.
+ */
+static bool announceLocalClipboard(rfbClient *client, ClipboardState *cb, const char *text, int length,
+                                   rfbBool *result) {
+    if (!serverSupportsClipboardAction(client, ClipboardActionNotify) ||
+        !serverSupportsClipboardAction(client, ClipboardActionProvide))
+        return false;
+
+    auto copy = (char *) malloc(length ? length : 1);
+    if (!copy) {
+        *result = FALSE;
+        return true;
+    }
+    memcpy(copy, text, length);
+
+    LOCK(cb->mutex);
+    free(cb->localText);
+    cb->localText = copy;
+    cb->localLength = length;
+    UNLOCK(cb->mutex);
+
+    *result = sendClipboardFlags(client, ClipboardActionNotify | ClipboardFormatText);
+    if (*result)
+        ++cb->notifySent;
+    return true;
+}
+
+/**
+ * Requests text previously announced by server.
+ * Returns false if there is nothing to request.
+ */
+static bool requestServerClipboard(rfbClient *client, ClipboardState *cb) {
+    if (!__atomic_exchange_n(&cb->serverHasText, false, __ATOMIC_ACQ_REL))
+        return false;
+
+    ++cb->requestSent;
+    return sendClipboardFlags(client, ClipboardActionRequest | ClipboardFormatText);
+}
+
+/**
+ * Reads & discards [length] bytes from server.
+ */
+static rfbBool skipServerBytes(rfbClient *client, uint32_t length) {
+    char chunk[4096];
+    while (length > 0) {
+        auto n = length < sizeof(chunk) ? length : (uint32_t) sizeof(chunk);
+        if (!ReadFromRFBServer(client, chunk, n))
+            return FALSE;
+        length -= n;
+    }
+    return TRUE;
+}
+
+static rfbBool readServerU32(rfbClient *client, uint32_t *value) {
+    uint32_t v;
+    if (!ReadFromRFBServer(client, (char *) &v, sizeof(v)))
+        return FALSE;
+    *value = rfbClientSwap32IfLE(v);
+    return TRUE;
+}
+
+/**
+ * Reads a Provide of [length] bytes, inflating it incrementally.
+ * Text larger than [maxSize] (0 means no limit) is dropped without being buffered.
+ */
+static rfbBool receiveClipboardProvide(rfbClient *client, ClipboardState *cb, uint32_t flags, uint32_t length,
+                                       int maxSize) {
+    if (!(flags & ClipboardFormatText))
+        return skipServerBytes(client, length);
+
+    z_stream zs = {};
+    if (inflateInit(&zs) != Z_OK)
+        return skipServerBytes(client, length);
+
+    uint8_t in[ClipboardReadChunk];
+    uint8_t sizeBytes[4];
+    uint32_t textSize = 0;  // Including terminator
+    char *text = nullptr;
+    bool done = false;      // Text is complete, or dropped
+    rfbBool result = TRUE;
+
+    zs.next_out = sizeBytes;
+    zs.avail_out = sizeof(sizeBytes);
+
+    while (length > 0) {
+        auto n = length < sizeof(in) ? length : ClipboardReadChunk;
+        if (!ReadFromRFBServer(client, (char *) in, n)) {
+            result = FALSE;
+            break;
+        }
+        length -= n;
+        if (done)
+            continue;
+
+        zs.next_in = in;
+        zs.avail_in = n;
+        while (zs.avail_in > 0 && !done) {
+            auto status = inflate(&zs, Z_NO_FLUSH);
+
+            if (!text && zs.avail_out == 0) { // Size header is complete
+                textSize = (uint32_t) sizeBytes[0] << 24 | sizeBytes[1] << 16 | sizeBytes[2] << 8 | sizeBytes[3];
+                if (textSize == 0 || (maxSize > 0 && textSize - 1 > (uint32_t) maxSize)) {
+                    rfbClientLog("Ignoring server clipboard of %u bytes (limit: %d)\n", textSize, maxSize);
+                    ++cb->provideDropped;
+                    done = true;
+                    break;
+                }
+                text = (char *) malloc(textSize);
+                if (!text) {
+                    done = true;
+                    break;
+                }
+                zs.next_out = (Bytef *) text;
+                zs.avail_out = textSize;
+                continue;
+            }
+
+            if (text && zs.avail_out == 0) { // Text is complete, other formats are ignored
+                done = true;
+                ++cb->provideReceived;
+                client->GotXCutTextUTF8(client, text, (int) strnlen(text, textSize));
+                break;
+            }
+
+            if (status != Z_OK) {
+                if (status != Z_STREAM_END)
+                    rfbClientErr("Clipboard: Inflate failed (%d)\n", status);
+                done = true;
+                break;
+            }
+        }
+    }
+
+    free(text);
+    inflateEnd(&zs);
+    return result;
+}
+
+/**
+ * Handles extended ServerCutText. [length] is the size of data following the header.
+ */
+static rfbBool handleExtendedClipboard(rfbClient *client, ClipboardState *cb, uint32_t length, int maxSize) {
+    uint32_t flags;
+    if (length < 4 || !readServerU32(client, &flags))
+        return FALSE;
+    length -= 4;
+
+    if (flags & ClipboardActionCaps) {
+        // One max size for each format, we don't need them
+        client->extendedClipboardServerCapabilities = (int) flags;
+        return skipServerBytes(client, length) && sendClipboardCaps(client, maxSize);
+    }
+
+    if (flags & ClipboardActionProvide)
+        return receiveClipboardProvide(client, cb, flags, length, maxSize);
+
+    if (!skipServerBytes(client, length))
+        return FALSE;
+
+    if (flags & ClipboardActionRequest)
+        return (flags & ClipboardFormatText) ? sendClipboardProvide(client, cb) : TRUE;
+
+    if (flags & ClipboardActionPeek) {
+        LOCK(cb->mutex);
+        auto available = cb->localText != nullptr;
+        UNLOCK(cb->mutex);
+        return sendClipboardFlags(client, ClipboardActionNotify | (available ? ClipboardFormatText : 0));
+    }
+
+    if (flags & ClipboardActionNotify) {
+        auto hasText = (flags & ClipboardFormatText) != 0;
+        __atomic_store_n(&cb->serverHasText, hasText, __ATOMIC_RELEASE);
+        if (hasText && cb->onServerTextAvailable)
+            cb->onServerTextAvailable(client);
+    }
+    return TRUE;
+}
+
+/**
+ * Handles legacy (Latin-1) ServerCutText.
+ */
+static rfbBool handleLegacyClipboard(rfbClient *client, uint32_t length, int maxSize) {
+    if (maxSize > 0 && length > (uint32_t) maxSize) {
+        rfbClientLog("Ignoring server cut text of %u bytes (limit: %d)\n", length, maxSize);
+        return skipServerBytes(client, length);
+    }
+
+    auto text = (char *) malloc(length + 1);
+    if (!text)
+        return skipServerBytes(client, length);
+
+    auto result = ReadFromRFBServer(client, text, length);
+    if (result) {
+        text[length] = 0;
+        client->GotXCutText(client, text, (int) length);
+    }
+    free(text);
+    return result;
+}
+
+/**
+ * Returns type of next server message, without consuming it.
+ * Must only be called when a message is available (see WaitForMessage()).
+ */
+static int peekServerMessageType(rfbClient *client) {
+    uint8_t type;
+    if (!ReadFromRFBServer(client, (char *) &type, 1))
+        return -1;
+
+    // ReadFromRFBServer() always reads through client->buf, so the byte is
+    // still there; step back over it.
+    client->bufoutptr--;
+    client->buffered++;
+    return type;
+}
+
+/**
+ * Handles next server message if it is ServerCutText.
+ * Sets *handled to false if it is some other message, which should be handled by LibVNCClient.
+ */
+static rfbBool handleServerCutText(rfbClient *client, ClipboardState *cb, int maxSize, bool *handled) {
+    *handled = false;
+    auto type = peekServerMessageType(client);
+    if (type < 0)
+        return FALSE;
+    if (type != ServerCutTextType)
+        return TRUE;
+
+    *handled = true;
+    uint8_t header[8]; // type, padding[3], length
+    if (!ReadFromRFBServer(client, (char *) header, sizeof(header)))
+        return FALSE;
+
+    auto length = (int32_t) ((uint32_t) header[4] << 24 | header[5] << 16 | header[6] << 8 | header[7]);
+    if (length < 0)
+        return handleExtendedClipboard(client, cb, (uint32_t) -(int64_t) length, maxSize);
+    else
+        return handleLegacyClipboard(client, (uint32_t) length, maxSize);
+}
+
+#endif //AVNC_CLIPBOARD_H
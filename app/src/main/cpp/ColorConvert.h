@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_COLORCONVERT_H
+#define AVNC_COLORCONVERT_H
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * YUV (BT.601, limited range) to framebuffer (BGRX) conversion.
+ *
+ * This runs for every pixel of every decoded H.264 frame, so it is vectorised
+ * with NEON (ARM) and SSE2 (x86). Vector versions use the same integer math as
+ * scalar version, so their output is bit-exact. Pixels which don't fill a whole
+ * vector are handled by scalar version. Callers go through kernels.yuvRowToBGRX
+ * (see CpuFeatures.h).
+ *
+ * [uStep] is the distance between consecutive chroma samples, which allows
+ * same routine to handle both planar (I420, uStep = 1) & semi-planar (NV12,
+ * uStep = 2) layouts.
+ */
+
+static inline uint8_t clampToByte(int v) {
+    return (uint8_t) (v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+static void yuvRowToBGRXScalar(uint32_t *dst, const uint8_t *yRow, const uint8_t *uRow, const uint8_t *vRow,
+                               int uStep, int width) {
+    for (int x = 0; x < width; ++x) {
+        int c = (yRow[x] - 16) * 298;
+        int d = uRow[(x >> 1) * uStep] - 128;
+        int e = vRow[(x >> 1) * uStep] - 128;
+
+        auto r = clampToByte((c + 409 * e + 128) >> 8);
+        auto g = clampToByte((c - 100 * d - 208 * e + 128) >> 8);
+        auto b = clampToByte((c + 516 * d + 128) >> 8);
+
+        dst[x] = (uint32_t) r << 16 | (uint32_t) g << 8 | b;
+    }
+}
+
+#if defined(__ARM_NEON)
+
+/**
+ * Converts 4 pixels, given as 16-bit (Y - 16), (U - 128) & (V - 128).
+ * Returns B, G & R values saturated to 16-bit.
+ */
+static inline void yuvToBGR4Neon(int16x4_t c, int16x4_t d, int16x4_t e,
+                                 uint16x4_t &b, uint16x4_t &g, uint16x4_t &r) {
+    auto y = vaddq_s32(vmull_n_s16(c, 298), vdupq_n_s32(128));
+    r = vqmovun_s32(vshrq_n_s32(vmlal_n_s16(y, e, 409), 8));
+    g = vqmovun_s32(vshrq_n_s32(vmlal_n_s16(vmlal_n_s16(y, d, -100), e, -208), 8));
+    b = vqmovun_s32(vshrq_n_s32(vmlal_n_s16(y, d, 516), 8));
+}
+
+static inline void yuvToBGRX8Neon(uint32_t *dst, uint8x8_t y8, uint8x8_t u8, uint8x8_t v8) {
+    auto c = vreinterpretq_s16_u16(vsubl_u8(y8, vdup_n_u8(16)));
+    auto d = vreinterpretq_s16_u16(vsubl_u8(u8, vdup_n_u8(128)));
+    auto e = vreinterpretq_s16_u16(vsubl_u8(v8, vdup_n_u8(128)));
+
+    uint16x4_t bl, gl, rl, bh, gh, rh;
+    yuvToBGR4Neon(vget_low_s16(c), vget_low_s16(d), vget_low_s16(e), bl, gl, rl);
+    yuvToBGR4Neon(vget_high_s16(c), vget_high_s16(d), vget_high_s16(e), bh, gh, rh);
+
+    uint8x8x4_t bgrx;
+    bgrx.val[0] = vqmovn_u16(vcombine_u16(bl, bh));
+    bgrx.val[1] = vqmovn_u16(vcombine_u16(gl, gh));
+    bgrx.val[2] = vqmovn_u16(vcombine_u16(rl, rh));
+    bgrx.val[3] = vdup_n_u8(0);
+    vst4_u8((uint8_t *) dst, bgrx);
+}
+
+static void yuvRowToBGRXNeon(uint32_t *dst, const uint8_t *yRow, const uint8_t *uRow, const uint8_t *vRow,
+                             int uStep, int width) {
+    bool planar = uStep == 1;
+    bool nv12 = uStep == 2 && vRow == uRow + 1;
+    int x = 0;
+
+    if (planar || nv12) {
+        for (; x + 16 <= width; x += 16) {
+            auto y = vld1q_u8(yRow + x);
+            uint8x8_t u, v;
+            if (planar) {
+                u = vld1_u8(uRow + x / 2);
+                v = vld1_u8(vRow + x / 2);
+            } else {
+                auto uv = vld2_u8(uRow + x);
+                u = uv.val[0];
+                v = uv.val[1];
+            }
+
+            // Each chroma sample covers two pixels
+            auto uu = vzip_u8(u, u);
+            auto vv = vzip_u8(v, v);
+            yuvToBGRX8Neon(dst + x, vget_low_u8(y), uu.val[0], vv.val[0]);
+            yuvToBGRX8Neon(dst + x + 8, vget_high_u8(y), uu.val[1], vv.val[1]);
+        }
+    }
+
+    yuvRowToBGRXScalar(dst + x, yRow + x, uRow + (x / 2) * uStep, vRow + (x / 2) * uStep, uStep, width - x);
+}
+
+#elif defined(__SSE2__)
+
+/**
+ * Computes (a * ka + b * kb) for 8 pixels of 16-bit a & b, as two 32-bit halves.
+ */
+static inline void mulAdd8SSE2(__m128i a, __m128i b, short ka, short kb, __m128i &lo, __m128i &hi) {
+    auto k = _mm_set1_epi32((int) ((uint32_t) (uint16_t) kb << 16 | (uint16_t) ka));
+    lo = _mm_madd_epi16(_mm_unpacklo_epi16(a, b), k);
+    hi = _mm_madd_epi16(_mm_unpackhi_epi16(a, b), k);
+}
+
+/**
+ * Rounds, shifts & saturates 8 32-bit values to bytes (in low half of result).
+ */
+static inline __m128i roundToBytesSSE2(__m128i lo, __m128i hi) {
+    auto round = _mm_set1_epi32(128);
+    lo = _mm_srai_epi32(_mm_add_epi32(lo, round), 8);
+    hi = _mm_srai_epi32(_mm_add_epi32(hi, round), 8);
+    auto packed = _mm_packs_epi32(lo, hi);
+    return _mm_packus_epi16(packed, packed);
+}
+
+static void yuvRowToBGRXSSE2(uint32_t *dst, const uint8_t *yRow, const uint8_t *uRow, const uint8_t *vRow,
+                             int uStep, int width) {
+    bool planar = uStep == 1;
+    bool nv12 = uStep == 2 && vRow == uRow + 1;
+    auto zero = _mm_setzero_si128();
+    int x = 0;
+
+    if (planar || nv12) {
+        for (; x + 8 <= width; x += 8) {
+            auto c = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (yRow + x)), zero),
+                                   _mm_set1_epi16(16));
+            __m128i u, v;
+            if (planar) {
+                int32_t u4, v4;
+                memcpy(&u4, uRow + x / 2, 4);
+                memcpy(&v4, vRow + x / 2, 4);
+                u = _mm_unpacklo_epi8(_mm_cvtsi32_si128(u4), _mm_cvtsi32_si128(u4));
+                v = _mm_unpacklo_epi8(_mm_cvtsi32_si128(v4), _mm_cvtsi32_si128(v4));
+                u = _mm_unpacklo_epi8(u, zero);
+                v = _mm_unpacklo_epi8(v, zero);
+            } else {
+                // U0 V0 U1 V1 ... -> U0 U0 U1 U1 ... & V0 V0 V1 V1 ...
+                auto uv = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (uRow + x)), zero);
+                u = _mm_shufflehi_epi16(_mm_shufflelo_epi16(uv, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 2, 0, 0));
+                v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(uv, _MM_SHUFFLE(3, 3, 1, 1)), _MM_SHUFFLE(3, 3, 1, 1));
+            }
+            auto d = _mm_sub_epi16(u, _mm_set1_epi16(128));
+            auto e = _mm_sub_epi16(v, _mm_set1_epi16(128));
+
+            __m128i lo, hi, lo2, hi2;
+            mulAdd8SSE2(c, e, 298, 409, lo, hi);
+            auto r = roundToBytesSSE2(lo, hi);
+
+            mulAdd8SSE2(c, d, 298, 516, lo, hi);
+            auto b = roundToBytesSSE2(lo, hi);
+
+            mulAdd8SSE2(c, d, 298, -100, lo, hi);
+            mulAdd8SSE2(e, zero, -208, 0, lo2, hi2);
+            auto g = roundToBytesSSE2(_mm_add_epi32(lo, lo2), _mm_add_epi32(hi, hi2));
+
+            auto bg = _mm_unpacklo_epi8(b, g);
+            auto rx = _mm_unpacklo_epi8(r, zero);
+            _mm_storeu_si128((__m128i *) (dst + x), _mm_unpacklo_epi16(bg, rx));
+            _mm_storeu_si128((__m128i *) (dst + x + 4), _mm_unpackhi_epi16(bg, rx));
+        }
+    }
+
+    yuvRowToBGRXScalar(dst + x, yRow + x, uRow + (x / 2) * uStep, vRow + (x / 2) * uStep, uStep, width - x);
+}
+
+#endif
+
+#endif //AVNC_COLORCONVERT_H
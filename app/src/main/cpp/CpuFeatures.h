@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_CPUFEATURES_H
+#define AVNC_CPUFEATURES_H
+
+#include <stdint.h>
+
+#if defined(__aarch64__) || defined(__arm__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+
+// AVX2 kernels are compiled for x86 regardless of baseline ISA, and are only
+// bound if the CPU supports them (see Kernels.h)
+#define AVNC_AVX2_KERNELS 1
+#define AVNC_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+/**
+ * Runtime CPU feature detection & pixel kernel table.
+ *
+ * Compile-time SIMD (NEON on ARM, SSE2 on x86) covers what every device of
+ * an ABI is guaranteed to have. Wider instruction sets vary between devices
+ * (AVX2 on x86 emulators & Chromebooks, for example), so hot pixel kernels are
+ * called through a table of function pointers, bound once in JNI_OnLoad
+ * according to detected features.
+ *
+ * Every kernel has a scalar reference. Vector variants produce bit-exact
+ * output of the reference, so the choice of variant is never visible.
+ *
+ * Framebuffer copies (blits) are not in the table: they are plain memcpy/memmove,
+ * for which Bionic already selects an implementation at runtime.
+ */
+
+struct CpuFeatures {
+    // ARM
+    bool neon;
+    bool dotprod;
+    bool sve;
+
+    // x86
+    bool sse41;
+    bool avx2;
+};
+
+static void detectCpuFeatures(CpuFeatures *features) {
+    *features = {};
+
+#if defined(__aarch64__)
+    auto hwcap = getauxval(AT_HWCAP);
+    features->neon = true; // Mandatory on ARMv8
+#ifdef HWCAP_ASIMDDP
+    features->dotprod = (hwcap & HWCAP_ASIMDDP) != 0;
+#endif
+#ifdef HWCAP_SVE
+    features->sve = (hwcap & HWCAP_SVE) != 0;
+#endif
+    (void) hwcap;
+#elif defined(__arm__)
+#ifdef HWCAP_NEON
+    features->neon = (getauxval(AT_HWCAP) & HWCAP_NEON) != 0;
+#endif
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    features->sse41 = __builtin_cpu_supports("sse4.1");
+    features->avx2 = __builtin_cpu_supports("avx2");
+#endif
+}
+
+struct PixelKernels {
+    // Fill: dst[i] = colour
+    void (*fillRow)(uint32_t *dst, uint32_t colour, int count);
+
+    // Convert: one row of YUV to BGRX (see ColorConvert.h)
+    void (*yuvRowToBGRX)(uint32_t *dst, const uint8_t *yRow, const uint8_t *uRow, const uint8_t *vRow,
+                         int uStep, int width);
+
+    // Composite: premultiplied cursor over framebuffer (see Cursor.h)
+    void (*blendCursorRow)(uint32_t *dst, const uint32_t *fb, const uint32_t *cursor, int32_t count);
+
+    // Downscale: vertical & horizontal 2:1 averages (see Downsample.h)
+    void (*averageRows)(uint32_t *dst, const uint32_t *a, const uint32_t *b, int count);
+    void (*halveRow)(uint32_t *dst, const uint32_t *src, int count);
+};
+
+// Bound in JNI_OnLoad, before anything else runs
+static CpuFeatures cpuFeatures;
+static PixelKernels kernels;
+
+#endif //AVNC_CPUFEATURES_H
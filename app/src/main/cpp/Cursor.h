@@ -9,6 +9,15 @@
 #ifndef AVNC_CURSOR_H
 #define AVNC_CURSOR_H
 
+#include "Scratch.h"
+#include "CpuFeatures.h"
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 
 /******************************************************************************
  * Some servers (e.g TigerVNC) may not send the cursor immediately after
@@ -51,11 +60,20 @@ const uint8_t DefaultCursorMask[DefaultCursorWidth * DefaultCursorHeight]
  * rfbClient struct does not maintain all cursor related information inside it.
  * Things like xHot, yHot are passed only via the cursor shape callback.
  * This wrapper holds all information necessary to render the cursor.
+ *
+ * Cursor shapes received from server (with 1-bit mask, or with alpha channel)
+ * are converted to premultiplied-alpha pixels once, when the shape changes.
+ * Pixels use framebuffer byte order, with alpha in the otherwise unused byte,
+ * i.e. 0xAARRGGBB. This allows us to render both kinds of shapes with a single
+ * branch-free blending kernel.
+ *
+ * Shapes are prepared by receiver thread in its own buffer, which is then
+ * swapped with [pixels]. Old pixel buffer is used for the next shape, so
+ * shape changes don't allocate once buffers are large enough.
  */
 struct Cursor {
-    uint8_t *buffer;
-    uint8_t *mask;
-    uint8_t *scratchBuffer; //Used during rendering
+    ScratchBuffer pixels;
+    ScratchBuffer scratch; //Used during rendering
     uint16_t width;
     uint16_t height;
     uint16_t xHot;
@@ -65,47 +83,205 @@ struct Cursor {
 //Only 4-byte pixels are currently supported
 const uint8_t PixelBytes = 4;
 
+//Cursor buffers are initially sized for shapes up to this size
+const uint16_t CursorPreallocSize = 64;
+
+//Larger shapes are rejected (real cursors are at most 256x256, even on HiDPI)
+const uint16_t CursorMaxSize = 512;
+
+/**
+ * 'Cursor With Alpha' pseudo-encoding.
+ * Shape is sent as premultiplied RGBA pixels, wrapped in another encoding.
+ */
+const int CursorWithAlphaEncoding = -314;
+
+/**
+ * Converts cursor shape with 1-bit mask to premultiplied pixels.
+ * Masked-out pixels become fully transparent, rest are fully opaque.
+ */
+void cursorPixelsFromMask(uint32_t *pixels, const uint8_t *buffer, const uint8_t *mask, size_t count) {
+    auto src = (const uint32_t *) buffer;
+    for (size_t i = 0; i < count; ++i)
+        pixels[i] = mask[i] ? (src[i] | 0xFF000000) : 0;
+}
+
+/**
+ * Converts premultiplied RGBA pixels (as received with 'Cursor With Alpha')
+ * to premultiplied 0xAARRGGBB pixels. Conversion can be done in-place.
+ */
+void cursorPixelsFromRGBA(uint32_t *pixels, const uint8_t *rgba, size_t count) {
+    for (size_t i = 0; i < count; ++i, rgba += 4) {
+        uint32_t a = rgba[3];
+        // Color components can't exceed alpha in premultiplied form.
+        // Clamping them protects blending from overflow with bad input.
+        uint32_t r = rgba[0] < a ? rgba[0] : a;
+        uint32_t g = rgba[1] < a ? rgba[1] : a;
+        uint32_t b = rgba[2] < a ? rgba[2] : a;
+        pixels[i] = a << 24 | r << 16 | g << 8 | b;
+    }
+}
+
 /**
  * Creates a new CursorData, initialized with default cursor info.
  */
 Cursor *newCursor() {
     auto cursor = (Cursor *) malloc(sizeof(Cursor));
     if (cursor) {
-        cursor->buffer = (uint8_t *) DefaultCursorBuffer;
-        cursor->mask = (uint8_t *) DefaultCursorMask;
-        cursor->scratchBuffer = (uint8_t *) malloc(DefaultCursorWidth * DefaultCursorHeight * PixelBytes);
-        cursor->width = DefaultCursorWidth;
-        cursor->height = DefaultCursorHeight;
-        cursor->xHot = DefaultCursorXHot;
-        cursor->yHot = DefaultCursorYHot;
+        cursor->pixels = {nullptr, 0};
+        cursor->scratch = {nullptr, 0};
+        cursor->width = cursor->height = 0;
+        cursor->xHot = cursor->yHot = 0;
+
+        const size_t prealloc = CursorPreallocSize * CursorPreallocSize;
+        auto pixels = reserveScratch(&cursor->pixels, prealloc);
+        if (pixels && reserveScratch(&cursor->scratch, prealloc)) {
+            cursorPixelsFromMask(pixels, (const uint8_t *) DefaultCursorBuffer, DefaultCursorMask,
+                                 DefaultCursorWidth * DefaultCursorHeight);
+            cursor->width = DefaultCursorWidth;
+            cursor->height = DefaultCursorHeight;
+            cursor->xHot = DefaultCursorXHot;
+            cursor->yHot = DefaultCursorYHot;
+        }
     }
     return cursor;
 }
 
-void freeCursorBuffers(Cursor *cursor) {
+void freeCursor(Cursor *cursor) {
     if (cursor) {
-        free(cursor->scratchBuffer);
-        if (cursor->buffer != (uint8_t *) DefaultCursorBuffer) free(cursor->buffer);
-        if (cursor->mask != (uint8_t *) DefaultCursorMask) free(cursor->mask);
+        freeScratch(&cursor->pixels);
+        freeScratch(&cursor->scratch);
     }
-}
-
-void freeCursor(Cursor *cursor) {
-    freeCursorBuffers(cursor);
     free(cursor);
 }
 
-void updateCursor(Cursor *cursor, uint8_t *buffer, uint8_t *mask, uint16_t width, uint16_t height,
-                  uint16_t xHot, uint16_t yHot) {
+/**
+ * Replaces cursor shape with the one in [shape]. Buffers are swapped, so
+ * [shape] receives the old pixels.
+ */
+void updateCursor(Cursor *cursor, ScratchBuffer *shape, uint16_t width, uint16_t height, uint16_t xHot, uint16_t yHot) {
+    // Keep the old shape if there is no memory for rendering the new one
+    if (!reserveScratch(&cursor->scratch, (size_t) width * height))
+        return;
 
-    freeCursorBuffers(cursor);
-    cursor->buffer = buffer;
-    cursor->mask = mask;
-    cursor->scratchBuffer = (uint8_t *) malloc(width * height * PixelBytes);
+    swapScratch(&cursor->pixels, shape);
     cursor->width = width;
     cursor->height = height;
     cursor->xHot = xHot;
     cursor->yHot = yHot;
 }
 
-#endif //AVNC_CURSOR_H
\ No newline at end of file
+/**
+ * Composites a row of premultiplied cursor pixels over framebuffer pixels:
+ *
+ *      dst = cursor + fb * (255 - cursorAlpha) / 255
+ *
+ * Red & blue channels are processed together in a single 32-bit lane.
+ * This is the reference for vector variants below, which compute the same
+ * rounded division on 16-bit channels. Callers go through kernels.blendCursorRow.
+ */
+void blendCursorRowScalar(uint32_t *dst, const uint32_t *fb, const uint32_t *cursor, int32_t count) {
+    for (int32_t i = 0; i < count; ++i) {
+        uint32_t src = cursor[i];
+        uint32_t bg = fb[i];
+        uint32_t ia = 255 - (src >> 24);
+
+        uint32_t rb = (bg & 0x00FF00FF) * ia + 0x00800080;
+        uint32_t g = (bg & 0x0000FF00) * ia + 0x00008000;
+
+        // Division by 255 with rounding
+        rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+        g = ((g + ((g >> 8) & 0x0000FF00)) >> 8) & 0x0000FF00;
+
+        dst[i] = (src & 0x00FFFFFF) + rb + g;
+    }
+}
+
+#if defined(__ARM_NEON)
+
+void blendCursorRowNeon(uint32_t *dst, const uint32_t *fb, const uint32_t *cursor, int32_t count) {
+    auto rgb = vdupq_n_u32(0x00FFFFFF);
+    int32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto src = vld1q_u32(cursor + i);
+        auto bg = vreinterpretq_u8_u32(vld1q_u32(fb + i));
+
+        // Inverse alpha, replicated to every byte of its pixel
+        auto ia = vsubq_u32(vdupq_n_u32(255), vshrq_n_u32(src, 24));
+        auto ia8 = vreinterpretq_u8_u32(vmulq_n_u32(ia, 0x01010101));
+
+        // (t + ((t + 128) >> 8) + 128) >> 8 is same as scalar division
+        auto lo = vmull_u8(vget_low_u8(bg), vget_low_u8(ia8));
+        auto hi = vmull_u8(vget_high_u8(bg), vget_high_u8(ia8));
+        auto blended = vcombine_u8(vraddhn_u16(lo, vrshrq_n_u16(lo, 8)), vraddhn_u16(hi, vrshrq_n_u16(hi, 8)));
+
+        vst1q_u32(dst + i, vaddq_u32(vandq_u32(src, rgb), vandq_u32(vreinterpretq_u32_u8(blended), rgb)));
+    }
+    blendCursorRowScalar(dst + i, fb + i, cursor + i, count - i);
+}
+
+#elif defined(__SSE2__)
+
+/**
+ * Scales 16-bit channels of two pixels by their inverse alpha, [ia] being
+ * replicated to all four channels of each pixel.
+ */
+static inline __m128i blendChannelsSSE2(__m128i channels, __m128i ia) {
+    auto t = _mm_add_epi16(_mm_mullo_epi16(channels, ia), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+void blendCursorRowSSE2(uint32_t *dst, const uint32_t *fb, const uint32_t *cursor, int32_t count) {
+    auto zero = _mm_setzero_si128();
+    auto rgb = _mm_set1_epi32(0x00FFFFFF);
+    int32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto src = _mm_loadu_si128((const __m128i *) (cursor + i));
+        auto bg = _mm_loadu_si128((const __m128i *) (fb + i));
+
+        auto ia = _mm_sub_epi32(_mm_set1_epi32(255), _mm_srli_epi32(src, 24));
+        ia = _mm_or_si128(ia, _mm_slli_epi32(ia, 16));
+
+        auto lo = blendChannelsSSE2(_mm_unpacklo_epi8(bg, zero), _mm_unpacklo_epi32(ia, ia));
+        auto hi = blendChannelsSSE2(_mm_unpackhi_epi8(bg, zero), _mm_unpackhi_epi32(ia, ia));
+        auto blended = _mm_packus_epi16(lo, hi);
+
+        _mm_storeu_si128((__m128i *) (dst + i), _mm_add_epi32(_mm_and_si128(src, rgb), _mm_and_si128(blended, rgb)));
+    }
+    blendCursorRowScalar(dst + i, fb + i, cursor + i, count - i);
+}
+
+#endif
+
+#if defined(AVNC_AVX2_KERNELS)
+
+// Same as SSE2 version, with unpacks & packs working within 128-bit lanes
+AVNC_TARGET_AVX2
+void blendCursorRowAVX2(uint32_t *dst, const uint32_t *fb, const uint32_t *cursor, int32_t count) {
+    auto zero = _mm256_setzero_si256();
+    auto rgb = _mm256_set1_epi32(0x00FFFFFF);
+    auto round = _mm256_set1_epi16(128);
+    int32_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto src = _mm256_loadu_si256((const __m256i *) (cursor + i));
+        auto bg = _mm256_loadu_si256((const __m256i *) (fb + i));
+
+        auto ia = _mm256_sub_epi32(_mm256_set1_epi32(255), _mm256_srli_epi32(src, 24));
+        ia = _mm256_or_si256(ia, _mm256_slli_epi32(ia, 16));
+
+        auto lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(bg, zero),
+                                                      _mm256_unpacklo_epi32(ia, ia)), round);
+        auto hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(bg, zero),
+                                                      _mm256_unpackhi_epi32(ia, ia)), round);
+        lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8);
+        hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+        auto blended = _mm256_packus_epi16(lo, hi);
+
+        _mm256_storeu_si256((__m256i *) (dst + i),
+                            _mm256_add_epi32(_mm256_and_si256(src, rgb), _mm256_and_si256(blended, rgb)));
+    }
+    blendCursorRowScalar(dst + i, fb + i, cursor + i, count - i);
+}
+
+#endif
+
+#endif //AVNC_CURSOR_H
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_DOWNSAMPLE_H
+#define AVNC_DOWNSAMPLE_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "UploadPlanner.h"
+#include "Scratch.h"
+#include "CpuFeatures.h"
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * Downsampled framebuffer.
+ *
+ * Framebuffers of very large desktops (8K, multi-monitor setups) can take
+ * more than 100 MB. To stay within a memory budget, client->frameBuffer can
+ * be stored at 1/2 or 1/4 of the server resolution. This is described by a
+ * 'shift': a pixel at (x, y) on server lands at (x >> shift, y >> shift) in
+ * the framebuffer.
+ *
+ * Everything outside this file, except the code talking to server, works in
+ * framebuffer coordinates. Incoming rectangles are box-downsampled while
+ * being written, and outgoing coordinates are scaled up.
+ *
+ * Downsampling by 4 is done as two successive passes of downsampling by 2,
+ * using rounding byte averages (which map directly to pavgb on SSE2 & vrhadd
+ * on NEON). Premultiplied alpha survives this, so cursors can use it too.
+ */
+
+static const int MaxFrameBufferShift = 2;
+
+static inline int scaledLength(int length, int shift) {
+    return (length + (1 << shift) - 1) >> shift;
+}
+
+/**
+ * Returns the smallest framebuffer rect covering given server rect.
+ */
+static inline UploadRect scaleRectDown(UploadRect r, int shift) {
+    if (shift == 0)
+        return r;
+
+    int left = r.x >> shift;
+    int top = r.y >> shift;
+    int right = scaledLength(r.x + r.w, shift);
+    int bottom = scaledLength(r.y + r.h, shift);
+    return {left, top, right - left, bottom - top};
+}
+
+static UploadRect scaleRectUp(UploadRect r, int shift) {
+    return {r.x << shift, r.y << shift, r.w << shift, r.h << shift};
+}
+
+/**
+ * Maps a framebuffer coordinate to the center of its box on server.
+ */
+static inline int scaleCoordinateUp(int v, int shift) {
+    return (v << shift) + ((1 << shift) >> 1);
+}
+
+/**
+ * Returns the shift required to keep framebuffer of given size within [budget].
+ * A budget of 0 means no limit.
+ */
+static int chooseFrameBufferShift(int width, int height, size_t budget) {
+    int shift = 0;
+    while (budget > 0 && shift < MaxFrameBufferShift &&
+           (size_t) scaledLength(width, shift) * scaledLength(height, shift) * 4 > budget)
+        ++shift;
+    return shift;
+}
+
+
+/******************************************************************************
+ * Kernels
+ *****************************************************************************/
+
+static inline uint32_t averagePixels(uint32_t a, uint32_t b) {
+    // Per-byte (a + b + 1) / 2, without unpacking
+    return (a | b) - (((a ^ b) >> 1) & 0x7F7F7F7F);
+}
+
+/**
+ * dst[i] = average(a[i], b[i])
+ */
+static void averageRowsScalar(uint32_t *dst, const uint32_t *a, const uint32_t *b, int count) {
+    for (int i = 0; i < count; ++i)
+        dst[i] = averagePixels(a[i], b[i]);
+}
+
+/**
+ * dst[i] = average(src[2i], src[2i + 1])
+ */
+static void halveRowScalar(uint32_t *dst, const uint32_t *src, int count) {
+    for (int i = 0; i < count; ++i)
+        dst[i] = averagePixels(src[2 * i], src[2 * i + 1]);
+}
+
+#if defined(__ARM_NEON)
+
+static void averageRowsNeon(uint32_t *dst, const uint32_t *a, const uint32_t *b, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        vst1q_u32(dst + i, vreinterpretq_u32_u8(vrhaddq_u8(vreinterpretq_u8_u32(vld1q_u32(a + i)),
+                                                           vreinterpretq_u8_u32(vld1q_u32(b + i)))));
+    averageRowsScalar(dst + i, a + i, b + i, count - i);
+}
+
+static void halveRowNeon(uint32_t *dst, const uint32_t *src, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto pairs = vld2q_u32(src + 2 * i);
+        vst1q_u32(dst + i, vreinterpretq_u32_u8(vrhaddq_u8(vreinterpretq_u8_u32(pairs.val[0]),
+                                                           vreinterpretq_u8_u32(pairs.val[1]))));
+    }
+    halveRowScalar(dst + i, src + 2 * i, count - i);
+}
+
+#elif defined(__SSE2__)
+
+static void averageRowsSSE2(uint32_t *dst, const uint32_t *a, const uint32_t *b, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_si128((__m128i *) (dst + i), _mm_avg_epu8(_mm_loadu_si128((const __m128i *) (a + i)),
+                                                             _mm_loadu_si128((const __m128i *) (b + i))));
+    averageRowsScalar(dst + i, a + i, b + i, count - i);
+}
+
+static void halveRowSSE2(uint32_t *dst, const uint32_t *src, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto lo = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *) (src + 2 * i)));
+        auto hi = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *) (src + 2 * i + 4)));
+        auto even = _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+        auto odd = _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+        _mm_storeu_si128((__m128i *) (dst + i), _mm_avg_epu8(even, odd));
+    }
+    halveRowScalar(dst + i, src + 2 * i, count - i);
+}
+
+#endif
+
+#if defined(AVNC_AVX2_KERNELS)
+
+AVNC_TARGET_AVX2
+static void averageRowsAVX2(uint32_t *dst, const uint32_t *a, const uint32_t *b, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_si256((__m256i *) (dst + i), _mm256_avg_epu8(_mm256_loadu_si256((const __m256i *) (a + i)),
+                                                                   _mm256_loadu_si256((const __m256i *) (b + i))));
+    averageRowsScalar(dst + i, a + i, b + i, count - i);
+}
+
+AVNC_TARGET_AVX2
+static void halveRowAVX2(uint32_t *dst, const uint32_t *src, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto lo = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i *) (src + 2 * i)));
+        auto hi = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i *) (src + 2 * i + 8)));
+
+        // Shuffles work within 128-bit lanes, so pairs come out as
+        // [0 2 | 8 10 | 4 6 | 12 14], which is put back in order after averaging.
+        auto even = _mm256_castps_si256(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+        auto odd = _mm256_castps_si256(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+        auto avg = _mm256_avg_epu8(even, odd);
+        _mm256_storeu_si256((__m256i *) (dst + i), _mm256_permute4x64_epi64(avg, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    halveRowScalar(dst + i, src + 2 * i, count - i);
+}
+
+#endif
+
+/******************************************************************************
+ * Block downsampling
+ *****************************************************************************/
+
+/**
+ * Downsamples a block of [w] x [h] pixels, located at (x, y) in its own
+ * resolution, by 2. [dst] points to the output pixel for (x / 2, y / 2).
+ *
+ * If the block doesn't start or end on even coordinates, boxes on the border
+ * only average the pixels which lie inside the block.
+ * [row] must have space for w + 2 pixels.
+ */
+static void halveBlock(uint32_t *dst, int dstStride, const uint32_t *src, int srcStride,
+                       int x, int y, int w, int h, uint32_t *row) {
+    int ox = x >> 1, oy = y >> 1;
+    int ow = ((x + w + 1) >> 1) - ox;
+    int oh = ((y + h + 1) >> 1) - oy;
+
+    // Leading pixel is duplicated for odd x, trailing pixel for odd end,
+    // so that every output pixel has a pair in row.
+    int lead = x & 1;
+
+    for (int j = 0; j < oh; ++j) {
+        int r0 = 2 * (oy + j) - y;
+        int r1 = r0 + 1;
+        if (r0 < 0) r0 = 0;
+        if (r1 > h - 1) r1 = h - 1;
+
+        auto out = dst + (size_t) j * dstStride;
+        kernels.averageRows(row + lead, src + (size_t) r0 * srcStride, src + (size_t) r1 * srcStride, w);
+        if (lead) row[0] = row[1];
+        if ((lead + w) & 1) row[lead + w] = row[lead + w - 1];
+
+        kernels.halveRow(out, row, ow);
+    }
+}
+
+/**
+ * Writes a block of [w] x [h] server pixels at server position (x, y) into
+ * a framebuffer stored at given shift. [frameBuffer] is the whole framebuffer.
+ * Returns false if scratch memory could not be allocated.
+ */
+static bool downsampleBlock(uint32_t *frameBuffer, int fbStride, const uint32_t *src, int srcStride,
+                            int x, int y, int w, int h, int shift, ScratchBuffer *scratch) {
+    // Row buffer, followed by the intermediate block (for shift 2)
+    int halfW = ((x + w + 1) >> 1) - (x >> 1);
+    int halfH = ((y + h + 1) >> 1) - (y >> 1);
+    size_t rowSize = (size_t) w + 2;
+    size_t needed = rowSize + (shift > 1 ? (size_t) halfW * halfH : 0);
+
+    auto row = reserveScratch(scratch, needed);
+    if (!row)
+        return false;
+
+    auto dst = frameBuffer + (size_t) (y >> shift) * fbStride + (x >> shift);
+    if (shift == 1) {
+        halveBlock(dst, fbStride, src, srcStride, x, y, w, h, row);
+        return true;
+    }
+
+    auto half = row + rowSize;
+    halveBlock(half, halfW, src, srcStride, x, y, w, h, row);
+    halveBlock(dst, fbStride, half, halfW, x >> 1, y >> 1, halfW, halfH, row);
+    return true;
+}
+
+#endif //AVNC_DOWNSAMPLE_H
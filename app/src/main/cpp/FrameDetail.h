@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_FRAMEDETAIL_H
+#define AVNC_FRAMEDETAIL_H
+
+#include <math.h>
+#include <string.h>
+#include <rfb/rfbclient.h>
+#include "UploadPlanner.h"
+#include "CpuFeatures.h"
+#include "Cursor.h"
+
+/**
+ * Full resolution region of a downsampled framebuffer.
+ *
+ * A downsampled framebuffer (see Downsample.h) is fine while most of the
+ * desktop is on screen. But once user zooms in beyond its density, each
+ * framebuffer pixel covers several screen pixels, and text becomes blurry.
+ * So a region around the viewport is also kept at server resolution, in its
+ * own buffer & texture, and is drawn over the framebuffer.
+ *
+ * Renderer picks the region (updateFrameDetailViewport), and receiver thread
+ * applies it (setFrameDetailRegionLocked). Parts which were not in previous
+ * region are filled from the framebuffer, and requested from server. From
+ * then on, writers copy the part of each incoming rectangle which falls
+ * inside the region.
+ *
+ * Region is larger than the viewport, so that small pans don't move it.
+ * Size is limited by a share of the framebuffer budget. If viewport is too
+ * large, only its center is restored.
+ *
+ * Pixels are handled like the framebuffer: receiver thread writes them
+ * without the framebuffer lock, others write them with the lock held, and
+ * buffer is only replaced (by receiver thread) with the lock held.
+ * Damage is tracked by a separate UploadPlanner, in region coordinates.
+ */
+
+// Region can use this fraction of framebuffer budget
+static const size_t FrameDetailBudgetDivisor = 4;
+
+// Region is this much larger (in area) than the part of viewport it is chosen for
+static const double FrameDetailSlack = 2.0;
+
+struct FrameDetail {
+    // Region in server coordinates, and its pixels. Empty if inactive.
+    UploadRect rect;
+    uint32_t *pixels;
+
+    // Damaged parts of region, yet to be uploaded to detail texture
+    UploadPlanner uploads;
+
+    // Cursor at server resolution, maintained while framebuffer is downsampled
+    Cursor *cursor;
+
+    // Region wanted by renderer, protected by requestMutex.
+    // requestPending is read without lock by receiver thread.
+    UploadRect requested;
+    bool requestPending;
+
+    // Stats
+    uint64_t regionCount;
+    uint64_t fetchedPixels;
+
+    MUTEX(requestMutex);
+};
+
+static void initFrameDetail(FrameDetail *detail) {
+    detail->rect = {0, 0, 0, 0};
+    detail->pixels = nullptr;
+    initUploadPlanner(&detail->uploads);
+    detail->cursor = nullptr;
+    detail->requested = {0, 0, 0, 0};
+    detail->requestPending = false;
+    detail->regionCount = 0;
+    detail->fetchedPixels = 0;
+    INIT_MUTEX(detail->requestMutex);
+}
+
+static void destroyFrameDetail(FrameDetail *detail) {
+    if (detail->regionCount)
+        log_info("Frame detail: %llu regions, %llu pixels fetched",
+                 (unsigned long long) detail->regionCount, (unsigned long long) detail->fetchedPixels);
+
+    free(detail->pixels);
+    destroyUploadPlanner(&detail->uploads);
+    freeCursor(detail->cursor);
+    TINI_MUTEX(detail->requestMutex);
+}
+
+static bool isFrameDetailActive(FrameDetail *detail) {
+    return detail->pixels != nullptr;
+}
+
+
+/******************************************************************************
+ * Region selection
+ *****************************************************************************/
+
+/**
+ * Scales [r] around its center. Result is clipped to [bounds].
+ */
+static UploadRect scaleRectAroundCenter(UploadRect r, double factor, UploadRect bounds) {
+    auto w = (int) (r.w * factor);
+    auto h = (int) (r.h * factor);
+    return intersectRects({r.x + (r.w - w) / 2, r.y + (r.h - h) / 2, w, h}, bounds);
+}
+
+/**
+ * Called by renderer with the part of desktop (in server coordinates) which
+ * should be shown at full resolution, empty if none. A new region is
+ * requested if current one doesn't cover it.
+ */
+static void updateFrameDetailViewport(FrameDetail *detail, UploadRect viewport, UploadRect desktop,
+                                      size_t maxPixels) {
+    // Part of viewport which needs to be covered
+    auto target = intersectRects(viewport, desktop);
+    auto area = (double) target.w * target.h;
+    auto maxTargetArea = maxPixels / FrameDetailSlack;
+    if (area > maxTargetArea)
+        target = scaleRectAroundCenter(target, sqrt(maxTargetArea / area), desktop);
+
+    LOCK(detail->requestMutex);
+
+    auto current = detail->requested;
+    UploadRect wanted = current;
+    if (isRectEmpty(target))
+        wanted = {0, 0, 0, 0};
+    else if (isRectEmpty(current) || !rectContains(current, target))
+        wanted = scaleRectAroundCenter(target, sqrt(FrameDetailSlack), desktop);
+
+    if (memcmp(&wanted, &current, sizeof(UploadRect)) != 0) {
+        detail->requested = wanted;
+        __atomic_store_n(&detail->requestPending, true, __ATOMIC_RELAXED);
+    }
+
+    UNLOCK(detail->requestMutex);
+}
+
+/**
+ * Returns region requested by renderer, if it has changed since last call.
+ */
+static bool takeFrameDetailRequest(FrameDetail *detail, UploadRect *rect) {
+    if (!__atomic_load_n(&detail->requestPending, __ATOMIC_RELAXED))
+        return false;
+
+    LOCK(detail->requestMutex);
+    *rect = detail->requested;
+    __atomic_store_n(&detail->requestPending, false, __ATOMIC_RELAXED);
+    UNLOCK(detail->requestMutex);
+    return true;
+}
+
+
+/******************************************************************************
+ * Pixel access
+ *****************************************************************************/
+
+static uint32_t *getFrameDetailPixel(FrameDetail *detail, int x, int y) {
+    return detail->pixels + (size_t) (y - detail->rect.y) * detail->rect.w + (x - detail->rect.x);
+}
+
+static void markFrameDetailDamage(FrameDetail *detail, UploadRect r) {
+    markDamage(&detail->uploads, r.x - detail->rect.x, r.y - detail->rect.y, r.w, r.h);
+}
+
+/**
+ * Fills [area] (in server coordinates) of the region by scaling up the
+ * framebuffer, stored at given [shift].
+ */
+static void fillFrameDetailFromFrameBuffer(FrameDetail *detail, const uint32_t *frameBuffer, int fbWidth,
+                                           int shift, UploadRect area) {
+    auto r = intersectRects(area, detail->rect);
+    if (!detail->pixels || isRectEmpty(r))
+        return;
+
+    for (int y = r.y; y < r.y + r.h; ++y) {
+        auto src = frameBuffer + (size_t) (y >> shift) * fbWidth;
+        auto dst = getFrameDetailPixel(detail, r.x, y);
+        for (int x = 0; x < r.w; ++x)
+            dst[x] = src[(r.x + x) >> shift];
+    }
+    markFrameDetailDamage(detail, r);
+}
+
+/**
+ * Copies full resolution pixels of [area] into the region. [src] points to
+ * the pixel at top-left corner of [area].
+ */
+static void writeFrameDetail(FrameDetail *detail, const uint32_t *src, int srcStride, UploadRect area) {
+    auto r = intersectRects(area, detail->rect);
+    if (!detail->pixels || isRectEmpty(r))
+        return;
+
+    src += (size_t) (r.y - area.y) * srcStride + (r.x - area.x);
+    auto dst = getFrameDetailPixel(detail, r.x, r.y);
+    auto rowBytes = r.w * sizeof(uint32_t);
+    for (int j = 0; j < r.h; ++j)
+        memcpy(dst + (size_t) j * detail->rect.w, src + (size_t) j * srcStride, rowBytes);
+    markFrameDetailDamage(detail, r);
+}
+
+static void fillFrameDetail(FrameDetail *detail, UploadRect area, uint32_t colour) {
+    auto r = intersectRects(area, detail->rect);
+    if (!detail->pixels || isRectEmpty(r))
+        return;
+
+    auto dst = getFrameDetailPixel(detail, r.x, r.y);
+    for (int j = 0; j < r.h; ++j)
+        kernels.fillRow(dst + (size_t) j * detail->rect.w, colour, r.w);
+    markFrameDetailDamage(detail, r);
+}
+
+/**
+ * Applies a CopyRect to the region. Must be called after framebuffer has
+ * been updated, which is used where source lies outside the region.
+ */
+static void copyFrameDetail(FrameDetail *detail, const uint32_t *frameBuffer, int fbWidth, int shift,
+                            int srcX, int srcY, int w, int h, int dstX, int dstY) {
+    auto to = intersectRects({dstX, dstY, w, h}, detail->rect);
+    if (!detail->pixels || isRectEmpty(to))
+        return;
+
+    UploadRect from = {to.x - dstX + srcX, to.y - dstY + srcY, to.w, to.h};
+    if (!rectContains(detail->rect, from)) {
+        fillFrameDetailFromFrameBuffer(detail, frameBuffer, fbWidth, shift, to);
+        return;
+    }
+
+    auto src = getFrameDetailPixel(detail, from.x, from.y);
+    auto dst = getFrameDetailPixel(detail, to.x, to.y);
+    auto stride = (size_t) detail->rect.w;
+    auto rowBytes = to.w * sizeof(uint32_t);
+
+    // Same as copyRectBGRX32
+    if (to.y <= from.y) {
+        for (int j = 0; j < to.h; ++j)
+            memmove(dst + j * stride, src + j * stride, rowBytes);
+    } else {
+        for (int j = to.h - 1; j >= 0; --j)
+            memmove(dst + j * stride, src + j * stride, rowBytes);
+    }
+    markFrameDetailDamage(detail, to);
+}
+
+
+/******************************************************************************
+ * Region management
+ *****************************************************************************/
+
+/**
+ * Frees the region. Renderer will request it again if still needed.
+ * Must be called with framebuffer lock held.
+ */
+static void releaseFrameDetailLocked(FrameDetail *detail) {
+    free(detail->pixels);
+    detail->pixels = nullptr;
+    detail->rect = {0, 0, 0, 0};
+    resizeUploadPlanner(&detail->uploads, 0, 0);
+
+    LOCK(detail->requestMutex);
+    if (!detail->requestPending)
+        detail->requested = {0, 0, 0, 0};
+    UNLOCK(detail->requestMutex);
+}
+
+/**
+ * Returns parts of [r] which lie outside [hole], at most 4.
+ */
+static int subtractRect(UploadRect r, UploadRect hole, UploadRect parts[4]) {
+    hole = intersectRects(r, hole);
+    if (isRectEmpty(hole)) {
+        parts[0] = r;
+        return 1;
+    }
+
+    int count = 0;
+    auto bottom = r.y + r.h, holeBottom = hole.y + hole.h;
+    if (hole.y > r.y)
+        parts[count++] = {r.x, r.y, r.w, hole.y - r.y};
+    if (holeBottom < bottom)
+        parts[count++] = {r.x, holeBottom, r.w, bottom - holeBottom};
+    if (hole.x > r.x)
+        parts[count++] = {r.x, hole.y, hole.x - r.x, hole.h};
+    if (hole.x + hole.w < r.x + r.w)
+        parts[count++] = {hole.x + hole.w, hole.y, r.x + r.w - (hole.x + hole.w), hole.h};
+    return count;
+}
+
+/**
+ * Moves the region to [rect]. Pixels shared with previous region are kept,
+ * rest are filled from the framebuffer, and returned in [missing], to be
+ * requested from server.
+ *
+ * Must be called by receiver thread, with framebuffer lock held.
+ * Returns the number of missing parts.
+ */
+static int setFrameDetailRegionLocked(FrameDetail *detail, UploadRect rect, const uint32_t *frameBuffer,
+                                      int fbWidth, int shift, UploadRect missing[4]) {
+    auto old = detail->rect;
+    if (memcmp(&old, &rect, sizeof(UploadRect)) == 0 && detail->pixels)
+        return 0;
+
+    auto pixels = isRectEmpty(rect) ? nullptr : (uint32_t *) malloc((size_t) rect.w * rect.h * sizeof(uint32_t));
+    if (!pixels || !resizeUploadPlanner(&detail->uploads, rect.w, rect.h)) {
+        free(pixels);
+        releaseFrameDetailLocked(detail);
+        return 0;
+    }
+
+    // Carry over the shared part
+    auto shared = intersectRects(old, rect);
+    bool keep = detail->pixels && !isRectEmpty(shared);
+    if (keep) {
+        auto src = getFrameDetailPixel(detail, shared.x, shared.y);
+        for (int j = 0; j < shared.h; ++j)
+            memcpy(pixels + (size_t) (shared.y - rect.y + j) * rect.w + (shared.x - rect.x),
+                   src + (size_t) j * old.w, shared.w * sizeof(uint32_t));
+    }
+
+    free(detail->pixels);
+    detail->pixels = pixels;
+    detail->rect = rect;
+    detail->regionCount++;
+
+    int count = 1;
+    if (keep)
+        count = subtractRect(rect, shared, missing);
+    else
+        missing[0] = rect;
+
+    for (int i = 0; i < count; ++i) {
+        fillFrameDetailFromFrameBuffer(detail, frameBuffer, fbWidth, shift, missing[i]);
+        detail->fetchedPixels += (uint64_t) missing[i].w * missing[i].h;
+    }
+    return count;
+}
+
+/**
+ * Keeps full resolution copy of cursor shape in [shape], see updateCursor().
+ * Must be called with framebuffer lock held.
+ */
+static void updateFrameDetailCursor(FrameDetail *detail, ScratchBuffer *shape, uint16_t width, uint16_t height,
+                                    uint16_t xHot, uint16_t yHot) {
+    if (!detail->cursor)
+        detail->cursor = newCursor();
+    if (detail->cursor)
+        updateCursor(detail->cursor, shape, width, height, xHot, yHot);
+}
+
+#endif //AVNC_FRAMEDETAIL_H
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_FRAMETEXTURE_H
+#define AVNC_FRAMETEXTURE_H
+
+#include <GLES3/gl3.h>
+#include <GLES2/gl2ext.h>
+#include "UploadPlanner.h"
+
+/**
+ * Uploads framebuffer data to the GL texture.
+ *
+ * On GLES2, sub-rectangles are repacked into a scratch buffer and uploaded
+ * synchronously from client memory.
+ *
+ * On GLES3, damaged tiles are staged into a ring of pixel buffer objects, and
+ * texture is updated from there. This avoids blocking the renderer while the
+ * driver copies client memory. GL_UNPACK_ROW_LENGTH allows uploading tiles
+ * directly from staged regions (or framebuffer) without repacking.
+ *
+ * If GL_EXT_texture_format_BGRA8888 is available, framebuffer data is uploaded
+ * as BGRA, so no swizzle is needed while sampling it. Otherwise, it is uploaded
+ * as RGBA, and shader flips the components.
+ *
+ * All functions must be called on renderer thread, with framebuffer lock held.
+ */
+
+static const int PboRingSize = 2;
+
+// Max bytes staged in a frame. Merged stages can include gaps, hence
+// the buffer is twice as large.
+static const size_t PboStageLimit = 4 * 1024 * 1024;
+static const size_t PboBufferSize = 2 * PboStageLimit;
+static const int MaxStagedTiles = (int) (PboStageLimit / (UploadTileSize * UploadTileSize * 4));
+
+struct FrameTexture {
+    bool gles3;
+    GLenum format;
+
+    // Staging buffers, 0 if not yet created. Reset when GL context changes.
+    GLuint pbo[PboRingSize];
+    int nextPbo;
+    bool pboFailed;
+
+    // Used for planning staged uploads
+    UploadRect tiles[MaxStagedTiles];
+    UploadStage stages[MaxStagedTiles];
+
+    // Stats
+    uint64_t stagedFrames;
+    uint64_t stagedBytes;
+};
+
+static void initFrameTexture(FrameTexture *texture) {
+    texture->gles3 = false;
+    texture->format = GL_RGBA;
+    for (auto &pbo: texture->pbo)
+        pbo = 0;
+    texture->nextPbo = 0;
+    texture->pboFailed = false;
+    texture->stagedFrames = 0;
+    texture->stagedBytes = 0;
+}
+
+static void logFrameTextureStats(FrameTexture *texture) {
+    if (texture->stagedFrames)
+        log_info("PBO uploads: %llu frames, %llu KB staged",
+                 (unsigned long long) texture->stagedFrames, (unsigned long long) texture->stagedBytes / 1024);
+}
+
+/**
+ * Called when a new GL context is created. Old buffers are destroyed along
+ * with old context, so they are simply forgotten.
+ */
+static void resetFrameTexture(FrameTexture *texture, bool gles3, bool bgra) {
+    texture->gles3 = gles3;
+    texture->format = bgra ? GL_BGRA_EXT : GL_RGBA;
+    for (auto &pbo: texture->pbo)
+        pbo = 0;
+    texture->nextPbo = 0;
+    texture->pboFailed = false;
+}
+
+static void allocateFrameTexture(FrameTexture *texture, int width, int height) {
+    glTexImage2D(GL_TEXTURE_2D, 0, (GLint) texture->format, width, height, 0,
+                 texture->format, GL_UNSIGNED_BYTE, nullptr);
+}
+
+/**
+ * Uploads given part of the framebuffer directly from client memory.
+ */
+static void uploadRectDirect(FrameTexture *texture, UploadPlanner *planner,
+                             const uint32_t *frameBuffer, int fbWidth, UploadRect r) {
+    auto fb = frameBuffer + (size_t) r.y * fbWidth + r.x;
+
+    if (texture->gles3) {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, fbWidth);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, texture->format, GL_UNSIGNED_BYTE, fb);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        return;
+    }
+
+    // GLES2 has no GL_UNPACK_ROW_LENGTH, so sub-rectangles narrower than
+    // the framebuffer must be repacked.
+    auto pixels = fb;
+    if (r.w != fbWidth) {
+        auto scratch = getUploadScratch(planner, (size_t) r.w * r.h);
+        if (!scratch)
+            return;
+
+        for (int y = 0; y < r.h; ++y)
+            memcpy(scratch + (size_t) y * r.w, fb + (size_t) y * fbWidth, r.w * sizeof(uint32_t));
+        pixels = scratch;
+    }
+
+    glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, texture->format, GL_UNSIGNED_BYTE, pixels);
+}
+
+/**
+ * Returns next staging buffer, mapped for writing, or nullptr on failure.
+ * Buffer is left bound to GL_PIXEL_UNPACK_BUFFER.
+ */
+static uint8_t *mapNextPbo(FrameTexture *texture, size_t size) {
+    if (texture->pboFailed)
+        return nullptr;
+
+    auto &pbo = texture->pbo[texture->nextPbo];
+    texture->nextPbo = (texture->nextPbo + 1) % PboRingSize;
+
+    if (pbo == 0)
+        glGenBuffers(1, &pbo);
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+
+    // Orphan previous storage, so that we don't wait for pending uploads from it
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr) PboBufferSize, nullptr, GL_STREAM_DRAW);
+    auto ptr = (uint8_t *) glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr) size,
+                                            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (!ptr) {
+        rfbClientErr("Could not map pixel buffer, falling back to direct uploads\n");
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        texture->pboFailed = true;
+    }
+    return ptr;
+}
+
+/**
+ * Uploads given tiles through a staging buffer.
+ * If [deadlineUs] passes while copying, remaining tiles are marked damaged again.
+ * Returns false if staging buffer is not available.
+ */
+static bool uploadTilesStaged(FrameTexture *texture, UploadPlanner *planner, const uint32_t *frameBuffer,
+                              int fbWidth, int tileCount, uint64_t deadlineUs) {
+    size_t totalBytes = 0;
+    auto stageCount = planStages(texture->tiles, tileCount, texture->stages, &totalBytes);
+    if (stageCount == 0)
+        return true;
+
+    auto buffer = mapNextPbo(texture, totalBytes);
+    if (!buffer)
+        return false;
+
+    // Copy stages into buffer
+    int copied = 0;
+    while (copied < stageCount) {
+        auto &stage = texture->stages[copied++];
+        auto r = stage.region;
+        auto dst = buffer + stage.offset;
+        auto src = frameBuffer + (size_t) r.y * fbWidth + r.x;
+        auto rowBytes = r.w * sizeof(uint32_t);
+
+        if (r.w == fbWidth) {
+            memcpy(dst, src, rowBytes * r.h);
+        } else {
+            for (int y = 0; y < r.h; ++y)
+                memcpy(dst + y * rowBytes, src + (size_t) y * fbWidth, rowBytes);
+        }
+
+        if (monotonicTimeUs() >= deadlineUs)
+            break;
+    }
+
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    // Upload from buffer. Here, the 'pixels' argument is an offset into the buffer.
+    for (int i = 0; i < copied; ++i) {
+        auto &stage = texture->stages[i];
+        auto region = stage.region;
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, region.w);
+
+        if (stage.contiguous) {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, region.x, region.y, region.w, region.h, texture->format,
+                            GL_UNSIGNED_BYTE, (const void *) stage.offset);
+            continue;
+        }
+
+        for (int t = stage.firstTile; t < stage.firstTile + stage.tileCount; ++t) {
+            auto r = texture->tiles[t];
+            auto offset = stage.offset + ((size_t) (r.y - region.y) * region.w + (r.x - region.x)) * sizeof(uint32_t);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, texture->format, GL_UNSIGNED_BYTE,
+                            (const void *) offset);
+        }
+    }
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    // Tiles which could not be copied in time
+    for (int i = copied; i < stageCount; ++i) {
+        auto &stage = texture->stages[i];
+        for (int t = stage.firstTile; t < stage.firstTile + stage.tileCount; ++t) {
+            auto r = texture->tiles[t];
+            markDamage(planner, r.x, r.y, r.w, r.h);
+        }
+    }
+
+    texture->stagedFrames++;
+    texture->stagedBytes += copied < stageCount ? texture->stages[copied].offset : totalBytes;
+    return true;
+}
+
+#endif //AVNC_FRAMETEXTURE_H
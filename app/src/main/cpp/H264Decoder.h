@@ -0,0 +1,781 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_H264DECODER_H
+#define AVNC_H264DECODER_H
+
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <media/NdkMediaCodec.h>
+#include <media/NdkMediaFormat.h>
+#include "ColorConvert.h"
+#include "CpuFeatures.h"
+
+/******************************************************************************
+ * Open H.264 encoding
+ *
+ * Each H.264 rectangle carries a chunk of an H.264 stream, and the stream
+ * is bound to that rectangle (a "context"). Decoding is done by Android's
+ * software AVC decoder, on a dedicated thread per client. Receiver thread
+ * only reads the payload and queues it, so it can continue reading the next
+ * message while previous one is being decoded.
+ *
+ * Decoded frames are written directly into the target rectangle of
+ * client->frameBuffer. Receiver thread waits for the queue to drain before
+ * finishing a framebuffer update, so rendering never sees a half-done update.
+ *
+ * Writing a large frame involves color conversion of every pixel, which is
+ * split into row bands and shared with a small pool of painter threads. Decoder
+ * thread paints too, and waits for all bands before releasing the frame, so the
+ * pipeline is: receiver -> decoder -> painters, with one frame in each stage.
+ *****************************************************************************/
+
+const int OpenH264Encoding = 50;
+
+// Flags sent with each rectangle
+const uint32_t OpenH264ResetContext = 1;
+const uint32_t OpenH264ResetAllContexts = 2;
+
+// Same limit as other popular implementations
+const int H264MaxContexts = 64;
+
+// Android color formats we can convert from
+const int32_t ColorFormatYUV420Planar = 19;     // I420
+const int32_t ColorFormatYUV420SemiPlanar = 21; // NV12
+
+// Painting is split among these many threads (in addition to decoder thread)
+const int H264MaxPainters = 3;
+
+// Smaller frames are painted by decoder thread alone, as handing
+// them to painters costs more than it saves.
+const int H264ParallelPaintMinPixels = 256 * 1024;
+
+const int64_t H264InputTimeoutUs = 100000;
+const int64_t H264OutputTimeoutUs = 100000;
+const int H264DrainTimeoutMs = 1000;
+
+// Decoded frames are kept for reuse, up to this many
+const int H264MaxSpareFrames = 4;
+
+// Upper bound for a rectangle's payload. Even an H.264 stream made entirely of
+// uncompressed (I_PCM) macroblocks takes 1.5 bytes per pixel, so anything
+// beyond 2 bytes per pixel (plus room for parameter sets) is bogus.
+const uint32_t H264PayloadOverhead = 64 * 1024;
+
+static uint64_t maxH264PayloadLength(uint16_t w, uint16_t h) {
+    return (uint64_t) w * h * 2 + H264PayloadOverhead;
+}
+
+/**
+ * Software decoders are preferred over hardware ones because they don't
+ * have constraints on frame size and don't buffer frames for long.
+ */
+const char *H264SoftwareDecoders[] = {"c2.android.avc.decoder", "OMX.google.h264.decoder"};
+
+/**
+ * A chunk of H.264 data queued for decoding.
+ * Frames are recycled, so [data] can be larger than [length].
+ */
+struct H264Frame {
+    uint16_t x, y, w, h;
+    uint32_t flags;
+    uint32_t length;
+    uint32_t capacity;
+    uint8_t *data;
+    H264Frame *next;
+};
+
+/**
+ * A decoder instance bound to a rectangle.
+ */
+struct H264Context {
+    uint16_t x, y, w, h;
+    AMediaCodec *codec;
+    int32_t colorFormat;
+    int32_t stride;
+    int32_t sliceHeight;
+    uint64_t lastUsed;  // Sequence number of last frame, used to evict contexts
+};
+
+/**
+ * Describes where to read a decoded frame from, and where to write it.
+ */
+struct H264PaintJob {
+    const uint8_t *yPlane, *uPlane, *vPlane;
+    int stride, uvStride, uvStep;
+    uint32_t *dst;
+    int dstStride;
+    int w, h;
+    int bandCount;
+};
+
+struct H264Decoder {
+    rfbClient *client; // Owner, set before decoder thread is started
+    pthread_t thread;
+    pthread_cond_t cond;
+    MUTEX(mutex);
+
+    // Frames waiting to be decoded, protected by mutex
+    H264Frame *head;
+    H264Frame *tail;
+
+    // Decoded frames available for reuse, protected by mutex
+    H264Frame *spareFrames;
+    int spareCount;
+    int pending;    // Queued + in-progress frames
+    size_t pendingBytes;
+    bool quit;
+
+    // Only accessed from decoder thread
+    H264Context contexts[H264MaxContexts];
+    uint64_t frameSeq;
+
+    // Painter pool. Current job & band counters are protected by paintMutex.
+    pthread_t painters[H264MaxPainters];
+    int painterCount;
+    pthread_cond_t paintCond;   // Signalled when a new job is posted
+    pthread_cond_t paintedCond; // Signalled when last band of a job is done
+    MUTEX(paintMutex);
+    H264PaintJob paintJob;
+    int nextBand;
+    int bandsDone;
+    bool paintQuit;
+
+    // Stats, updated under mutex
+    uint64_t bytesReceived;
+    uint64_t framesDecoded;
+    uint64_t decodeTimeUs;
+
+    // Only accessed from decoder thread
+    ScratchBuffer fullFrame;
+    ScratchBuffer downsampleScratch;
+    uint64_t framesPaintedInParallel;
+    uint64_t paintTimeUs;
+};
+
+
+/******************************************************************************
+ * Painting
+ *****************************************************************************/
+
+static void paintBand(const H264PaintJob *job, int band) {
+    auto rowsPerBand = (job->h + job->bandCount - 1) / job->bandCount;
+    auto first = band * rowsPerBand;
+    auto last = first + rowsPerBand < job->h ? first + rowsPerBand : job->h;
+
+    for (int y = first; y < last; ++y) {
+        auto uvOffset = (size_t) (y >> 1) * job->uvStride;
+        kernels.yuvRowToBGRX(job->dst + (size_t) y * job->dstStride, job->yPlane + (size_t) y * job->stride,
+                             job->uPlane + uvOffset, job->vPlane + uvOffset, job->uvStep, job->w);
+    }
+}
+
+/**
+ * Claims & paints bands of current job until none is left.
+ * Must be called with paintMutex held.
+ */
+static void paintAvailableBands(H264Decoder *decoder) {
+    auto job = &decoder->paintJob;
+    while (decoder->nextBand < job->bandCount) {
+        auto band = decoder->nextBand++;
+        UNLOCK(decoder->paintMutex);
+        paintBand(job, band);
+        LOCK(decoder->paintMutex);
+
+        if (++decoder->bandsDone == job->bandCount)
+            pthread_cond_signal(&decoder->paintedCond);
+    }
+}
+
+static THREAD_ROUTINE_RETURN_TYPE h264PainterThread(void *arg) {
+    auto decoder = (H264Decoder *) arg;
+
+    LOCK(decoder->paintMutex);
+    while (!decoder->paintQuit) {
+        paintAvailableBands(decoder);
+        pthread_cond_wait(&decoder->paintCond, &decoder->paintMutex);
+    }
+    UNLOCK(decoder->paintMutex);
+
+    return THREAD_ROUTINE_RETURN_VALUE;
+}
+
+static void startPainters(H264Decoder *decoder) {
+    INIT_MUTEX(decoder->paintMutex);
+    pthread_cond_init(&decoder->paintCond, nullptr);
+    pthread_cond_init(&decoder->paintedCond, nullptr);
+
+    // Decoder thread is also painting, and codec has its own threads
+    long cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+    int count = cpuCount <= 2 ? 0 : (int) (cpuCount / 2);
+    if (count > H264MaxPainters) count = H264MaxPainters;
+
+    for (int i = 0; i < count; ++i) {
+        if (pthread_create(&decoder->painters[decoder->painterCount], nullptr, h264PainterThread, decoder) != 0)
+            break;
+        decoder->painterCount++;
+    }
+}
+
+static void stopPainters(H264Decoder *decoder) {
+    LOCK(decoder->paintMutex);
+    decoder->paintQuit = true;
+    pthread_cond_broadcast(&decoder->paintCond);
+    UNLOCK(decoder->paintMutex);
+
+    for (int i = 0; i < decoder->painterCount; ++i)
+        pthread_join(decoder->painters[i], nullptr);
+
+    pthread_cond_destroy(&decoder->paintedCond);
+    pthread_cond_destroy(&decoder->paintCond);
+    TINI_MUTEX(decoder->paintMutex);
+}
+
+/**
+ * Paints given job, sharing it with painters if worthwhile.
+ * Returns after all bands have been painted.
+ */
+static void runPaintJob(H264Decoder *decoder, H264PaintJob job) {
+    auto start = monotonicTimeUs();
+
+    if (decoder->painterCount == 0 || job.w * job.h < H264ParallelPaintMinPixels) {
+        job.bandCount = 1;
+        paintBand(&job, 0);
+    } else {
+        // A few bands per thread, so that a slow thread doesn't hold up others
+        job.bandCount = (decoder->painterCount + 1) * 2;
+
+        LOCK(decoder->paintMutex);
+        decoder->paintJob = job;
+        decoder->nextBand = 0;
+        decoder->bandsDone = 0;
+        pthread_cond_broadcast(&decoder->paintCond);
+
+        paintAvailableBands(decoder);
+        while (decoder->bandsDone < job.bandCount)
+            pthread_cond_wait(&decoder->paintedCond, &decoder->paintMutex);
+        UNLOCK(decoder->paintMutex);
+
+        decoder->framesPaintedInParallel++;
+    }
+
+    decoder->paintTimeUs += monotonicTimeUs() - start;
+}
+
+/**
+ * Writes a decoded frame to the framebuffer.
+ * Caller must hold the framebuffer lock.
+ */
+static void writeYUVFrame(ClientEx *ex, rfbClient *client, H264Decoder *decoder, H264Context *ctx,
+                          const uint8_t *yuv, size_t size) {
+    // Framebuffer might have been resized while this frame was in the queue
+    auto target = scaleRectDown({ctx->x, ctx->y, ctx->w, ctx->h}, ex->fbShift);
+    if (!client->frameBuffer || target.x + target.w > ex->fbRealWidth || target.y + target.h > ex->fbRealHeight)
+        return;
+
+    auto stride = ctx->stride > 0 ? ctx->stride : ctx->w;
+    auto sliceHeight = ctx->sliceHeight > 0 ? ctx->sliceHeight : ctx->h;
+    auto ySize = (size_t) stride * sliceHeight;
+    auto uvHeight = (ctx->h + 1) / 2;
+
+    const uint8_t *uPlane, *vPlane;
+    int uvStride, uvStep;
+
+    if (ctx->colorFormat == ColorFormatYUV420Planar) {
+        uvStride = (stride + 1) / 2;
+        uPlane = yuv + ySize;
+        vPlane = uPlane + (size_t) uvStride * ((sliceHeight + 1) / 2);
+        uvStep = 1;
+    } else if (ctx->colorFormat == ColorFormatYUV420SemiPlanar) {
+        uvStride = stride;
+        uPlane = yuv + ySize;
+        vPlane = uPlane + 1;
+        uvStep = 2;
+    } else {
+        return;
+    }
+
+    if (vPlane + (size_t) uvStride * (uvHeight - 1) + ((ctx->w - 1) / 2) * uvStep >= yuv + size) {
+        rfbClientErr("H.264: Decoded frame is smaller than expected\n");
+        return;
+    }
+
+    LazyJpegTarget fb = {(uint32_t *) client->frameBuffer, ex->fbRealWidth, ex->fbRealHeight, ex->fbShift,
+                         &ex->detail};
+    resolveLazyJpegs(&ex->jpeg, &ex->uploads, fb, {ctx->x, ctx->y, ctx->w, ctx->h}, true);
+
+    H264PaintJob job{};
+    job.yPlane = yuv;
+    job.uPlane = uPlane;
+    job.vPlane = vPlane;
+    job.stride = stride;
+    job.uvStride = uvStride;
+    job.uvStep = uvStep;
+    job.dst = fb.frameBuffer + (size_t) ctx->y * fb.width + ctx->x;
+    job.dstStride = fb.width;
+    job.w = ctx->w;
+    job.h = ctx->h;
+
+    // For a downsampled framebuffer, frame is painted at full resolution into
+    // scratch memory, and downsampled from there.
+    if (fb.shift) {
+        job.dst = reserveScratch(&decoder->fullFrame, (size_t) ctx->w * ctx->h);
+        job.dstStride = ctx->w;
+        if (!job.dst)
+            return;
+    }
+
+    runPaintJob(decoder, job);
+
+    if (fb.shift) {
+        downsampleBlock(fb.frameBuffer, fb.width, job.dst, ctx->w, ctx->x, ctx->y, ctx->w, ctx->h, fb.shift,
+                        &decoder->downsampleScratch);
+        writeFrameDetail(fb.detail, job.dst, ctx->w, {ctx->x, ctx->y, ctx->w, ctx->h});
+    }
+
+    // LibVNCClient reports the rect as soon as it is queued, which might be
+    // before it is written, so report it again.
+    markDamage(&ex->uploads, target.x, target.y, target.w, target.h);
+}
+
+
+/******************************************************************************
+ * Context management
+ *****************************************************************************/
+
+static void releaseContext(H264Context *ctx) {
+    if (ctx->codec) {
+        AMediaCodec_stop(ctx->codec);
+        AMediaCodec_delete(ctx->codec);
+    }
+    memset(ctx, 0, sizeof(H264Context));
+}
+
+static AMediaCodec *createAVCDecoder(uint16_t width, uint16_t height) {
+    auto format = AMediaFormat_new();
+    AMediaFormat_setString(format, AMEDIAFORMAT_KEY_MIME, "video/avc");
+    AMediaFormat_setInt32(format, AMEDIAFORMAT_KEY_WIDTH, width);
+    AMediaFormat_setInt32(format, AMEDIAFORMAT_KEY_HEIGHT, height);
+    AMediaFormat_setInt32(format, AMEDIAFORMAT_KEY_COLOR_FORMAT, ColorFormatYUV420Planar);
+    AMediaFormat_setInt32(format, "low-latency", 1);
+
+    AMediaCodec *codec = nullptr;
+
+    for (auto name: H264SoftwareDecoders) {
+        codec = AMediaCodec_createCodecByName(name);
+        if (codec && AMediaCodec_configure(codec, format, nullptr, nullptr, 0) == AMEDIA_OK)
+            break;
+        if (codec) AMediaCodec_delete(codec);
+        codec = nullptr;
+    }
+
+    // Fallback to whatever the platform offers
+    if (!codec) {
+        codec = AMediaCodec_createDecoderByType("video/avc");
+        if (codec && AMediaCodec_configure(codec, format, nullptr, nullptr, 0) != AMEDIA_OK) {
+            AMediaCodec_delete(codec);
+            codec = nullptr;
+        }
+    }
+
+    AMediaFormat_delete(format);
+
+    if (codec && AMediaCodec_start(codec) != AMEDIA_OK) {
+        AMediaCodec_delete(codec);
+        codec = nullptr;
+    }
+
+    return codec;
+}
+
+/**
+ * Returns context for given frame, creating a new one if required.
+ * If all contexts are in use, least recently used context is evicted.
+ */
+static H264Context *getContext(H264Decoder *decoder, H264Frame *frame) {
+    H264Context *match = nullptr, *unused = nullptr, *oldest = nullptr;
+
+    for (auto &ctx: decoder->contexts) {
+        if (!ctx.codec) {
+            if (!unused) unused = &ctx;
+            continue;
+        }
+        if (ctx.x == frame->x && ctx.y == frame->y && ctx.w == frame->w && ctx.h == frame->h) {
+            match = &ctx;
+            break;
+        }
+        if (!oldest || ctx.lastUsed < oldest->lastUsed)
+            oldest = &ctx;
+    }
+
+    if (match && (frame->flags & OpenH264ResetContext))
+        releaseContext(match);
+    else if (match)
+        return match;
+
+    auto ctx = match ? match : (unused ? unused : oldest);
+    releaseContext(ctx);
+
+    ctx->codec = createAVCDecoder(frame->w, frame->h);
+    if (!ctx->codec) {
+        rfbClientErr("H.264: Could not create decoder for %dx%d\n", frame->w, frame->h);
+        return nullptr;
+    }
+
+    ctx->x = frame->x;
+    ctx->y = frame->y;
+    ctx->w = frame->w;
+    ctx->h = frame->h;
+    ctx->colorFormat = ColorFormatYUV420Planar;
+    return ctx;
+}
+
+static void updateOutputFormat(H264Context *ctx) {
+    auto format = AMediaCodec_getOutputFormat(ctx->codec);
+    if (!format)
+        return;
+
+    int32_t value;
+    if (AMediaFormat_getInt32(format, AMEDIAFORMAT_KEY_COLOR_FORMAT, &value)) ctx->colorFormat = value;
+    if (AMediaFormat_getInt32(format, AMEDIAFORMAT_KEY_STRIDE, &value)) ctx->stride = value;
+    if (AMediaFormat_getInt32(format, "slice-height", &value)) ctx->sliceHeight = value;
+    AMediaFormat_delete(format);
+
+    if (ctx->colorFormat != ColorFormatYUV420Planar && ctx->colorFormat != ColorFormatYUV420SemiPlanar)
+        rfbClientErr("H.264: Unsupported output color format: %d\n", ctx->colorFormat);
+}
+
+
+/******************************************************************************
+ * Decoding
+ *****************************************************************************/
+
+/**
+ * Writes all available output of [ctx] to framebuffer.
+ * If [waitForFirst] is true, we wait a little for the decoder to produce
+ * the first output buffer.
+ */
+static void drainOutput(rfbClient *client, H264Decoder *decoder, H264Context *ctx, bool waitForFirst) {
+    auto ex = getClientExtension(client);
+    auto timeout = waitForFirst ? H264OutputTimeoutUs : 0;
+
+    while (true) {
+        AMediaCodecBufferInfo info{};
+        auto index = AMediaCodec_dequeueOutputBuffer(ctx->codec, &info, timeout);
+
+        if (index == AMEDIACODEC_INFO_OUTPUT_FORMAT_CHANGED) {
+            updateOutputFormat(ctx);
+            continue;
+        }
+        if (index == AMEDIACODEC_INFO_OUTPUT_BUFFERS_CHANGED)
+            continue;
+        if (index < 0)
+            break;
+
+        size_t size = 0;
+        auto buffer = AMediaCodec_getOutputBuffer(ctx->codec, index, &size);
+        if (buffer && info.size > 0) {
+            LOCK(ex->mutex);
+            writeYUVFrame(ex, client, decoder, ctx, buffer + info.offset, info.size);
+            UNLOCK(ex->mutex);
+        }
+        AMediaCodec_releaseOutputBuffer(ctx->codec, index, false);
+        timeout = 0;
+    }
+}
+
+static void decodeFrame(rfbClient *client, H264Decoder *decoder, H264Frame *frame) {
+    if (frame->flags & OpenH264ResetAllContexts)
+        for (auto &ctx: decoder->contexts)
+            releaseContext(&ctx);
+
+    if (frame->length == 0 || frame->w == 0 || frame->h == 0)
+        return;
+
+    auto ctx = getContext(decoder, frame);
+    if (!ctx)
+        return;
+
+    ctx->lastUsed = ++decoder->frameSeq;
+
+    auto index = AMediaCodec_dequeueInputBuffer(ctx->codec, H264InputTimeoutUs);
+    if (index < 0) {
+        rfbClientErr("H.264: No input buffer available, dropping frame\n");
+        return;
+    }
+
+    size_t capacity = 0;
+    auto input = AMediaCodec_getInputBuffer(ctx->codec, index, &capacity);
+    if (!input || capacity < frame->length) {
+        rfbClientErr("H.264: Frame too large for input buffer (%u > %zu)\n", frame->length, capacity);
+        AMediaCodec_queueInputBuffer(ctx->codec, index, 0, 0, decoder->frameSeq, 0);
+        return;
+    }
+
+    memcpy(input, frame->data, frame->length);
+    AMediaCodec_queueInputBuffer(ctx->codec, index, 0, frame->length, decoder->frameSeq, 0);
+
+    drainOutput(client, decoder, ctx, true);
+}
+
+static void freeH264Frame(H264Frame *frame) {
+    free(frame->data);
+    free(frame);
+}
+
+/**
+ * Keeps a decoded frame for reuse. Must be called with decoder->mutex held.
+ */
+static void recycleH264Frame(H264Decoder *decoder, H264Frame *frame) {
+    if (decoder->spareCount >= H264MaxSpareFrames) {
+        freeH264Frame(frame);
+        return;
+    }
+    frame->next = decoder->spareFrames;
+    decoder->spareFrames = frame;
+    decoder->spareCount++;
+}
+
+static void freeSpareH264Frames(H264Decoder *decoder) {
+    while (decoder->spareFrames) {
+        auto frame = decoder->spareFrames;
+        decoder->spareFrames = frame->next;
+        freeH264Frame(frame);
+    }
+    decoder->spareCount = 0;
+}
+
+/**
+ * Returns a frame with space for at least [length] bytes of data.
+ */
+static H264Frame *acquireH264Frame(H264Decoder *decoder, uint32_t length) {
+    LOCK(decoder->mutex);
+    auto frame = decoder->spareFrames;
+    if (frame) {
+        decoder->spareFrames = frame->next;
+        decoder->spareCount--;
+    }
+    UNLOCK(decoder->mutex);
+
+    if (!frame && !(frame = (H264Frame *) calloc(1, sizeof(H264Frame))))
+        return nullptr;
+
+    if (length > frame->capacity) {
+        auto capacity = frame->capacity + frame->capacity / 2;
+        if (capacity < length) capacity = length;
+
+        free(frame->data);
+        frame->data = (uint8_t *) malloc(capacity);
+        frame->capacity = frame->data ? capacity : 0;
+        if (!frame->data) {
+            free(frame);
+            return nullptr;
+        }
+    }
+    frame->next = nullptr;
+    return frame;
+}
+
+static THREAD_ROUTINE_RETURN_TYPE h264DecoderThread(void *arg) {
+    // ex->h264 is cleared before this thread is stopped (see nativeCleanup),
+    // so decoder is passed along instead of being looked up from client.
+    auto decoder = (H264Decoder *) arg;
+    auto client = decoder->client;
+
+    LOCK(decoder->mutex);
+    while (true) {
+        while (!decoder->head && !decoder->quit)
+            pthread_cond_wait(&decoder->cond, &decoder->mutex);
+
+        if (decoder->quit)
+            break;
+
+        auto frame = decoder->head;
+        decoder->head = frame->next;
+        if (!decoder->head) decoder->tail = nullptr;
+        UNLOCK(decoder->mutex);
+
+        auto start = monotonicTimeUs();
+        decodeFrame(client, decoder, frame);
+        auto elapsed = monotonicTimeUs() - start;
+
+        LOCK(decoder->mutex);
+        decoder->pending--;
+        decoder->pendingBytes -= frame->length;
+        recycleH264Frame(decoder, frame);
+        decoder->framesDecoded++;
+        decoder->decodeTimeUs += elapsed;
+        pthread_cond_broadcast(&decoder->cond);
+    }
+    UNLOCK(decoder->mutex);
+
+    for (auto &ctx: decoder->contexts)
+        releaseContext(&ctx);
+
+    return THREAD_ROUTINE_RETURN_VALUE;
+}
+
+
+/******************************************************************************
+ * Decoder lifecycle (called from receiver thread)
+ *****************************************************************************/
+
+H264Decoder *newH264Decoder(rfbClient *client) {
+    auto decoder = (H264Decoder *) calloc(1, sizeof(H264Decoder));
+    if (!decoder)
+        return nullptr;
+
+    INIT_MUTEX(decoder->mutex);
+    pthread_cond_init(&decoder->cond, nullptr);
+
+    startPainters(decoder);
+
+    decoder->client = client;
+    getClientExtension(client)->h264 = decoder;
+    if (pthread_create(&decoder->thread, nullptr, h264DecoderThread, decoder) != 0) {
+        getClientExtension(client)->h264 = nullptr;
+        stopPainters(decoder);
+        pthread_cond_destroy(&decoder->cond);
+        TINI_MUTEX(decoder->mutex);
+        free(decoder);
+        return nullptr;
+    }
+    return decoder;
+}
+
+/**
+ * Reads an H.264 rectangle from server and queues it for decoding.
+ */
+rfbBool queueH264Rect(rfbClient *client, H264Decoder *decoder, rfbFramebufferUpdateRectHeader *rect) {
+    uint32_t header[2]; // length, flags
+    if (!ReadFromRFBServer(client, (char *) header, sizeof(header)))
+        return FALSE;
+
+    auto length = rfbClientSwap32IfLE(header[0]);
+    if (length > maxH264PayloadLength(rect->r.w, rect->r.h)) {
+        rfbClientErr("H.264: Payload too large for %dx%d rect (%u bytes)\n", rect->r.w, rect->r.h, length);
+        return FALSE;
+    }
+
+    auto frame = acquireH264Frame(decoder, length);
+    if (!frame)
+        return FALSE;
+
+    frame->x = rect->r.x;
+    frame->y = rect->r.y;
+    frame->w = rect->r.w;
+    frame->h = rect->r.h;
+    frame->length = length;
+    frame->flags = rfbClientSwap32IfLE(header[1]);
+
+    if (length > 0 && !ReadFromRFBServer(client, (char *) frame->data, length)) {
+        freeH264Frame(frame);
+        return FALSE;
+    }
+
+    LOCK(decoder->mutex);
+    if (decoder->tail) decoder->tail->next = frame;
+    else decoder->head = frame;
+    decoder->tail = frame;
+    decoder->pending++;
+    decoder->pendingBytes += frame->length;
+    decoder->bytesReceived += frame->length;
+    pthread_cond_broadcast(&decoder->cond);
+    UNLOCK(decoder->mutex);
+
+    return TRUE;
+}
+
+/**
+ * Blocks until all queued frames are decoded (or timeout expires).
+ */
+void waitForH264Decoder(H264Decoder *decoder) {
+    timespec deadline{};
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += H264DrainTimeoutMs / 1000;
+
+    LOCK(decoder->mutex);
+    while (decoder->pending > 0) {
+        if (pthread_cond_timedwait(&decoder->cond, &decoder->mutex, &deadline) != 0) {
+            rfbClientErr("H.264: Timed out waiting for decoder\n");
+            break;
+        }
+    }
+    UNLOCK(decoder->mutex);
+}
+
+/**
+ * Returns bytes held in queued frames & painting scratch memory.
+ */
+void getH264MemoryUsage(H264Decoder *decoder, size_t *queued, size_t *scratch) {
+    LOCK(decoder->mutex);
+    *queued = decoder->pendingBytes + decoder->pending * sizeof(H264Frame);
+    *scratch = (decoder->fullFrame.capacity + decoder->downsampleScratch.capacity) * sizeof(uint32_t);
+    for (auto frame = decoder->spareFrames; frame; frame = frame->next)
+        *scratch += sizeof(H264Frame) + frame->capacity;
+    UNLOCK(decoder->mutex);
+}
+
+/**
+ * Frees spare frames, and painting scratch memory if decoder is idle.
+ * Scratch memory is only touched while a frame is in progress, i.e. pending > 0.
+ * Returns the number of bytes freed.
+ */
+size_t trimH264Decoder(H264Decoder *decoder) {
+    size_t freed = 0;
+    LOCK(decoder->mutex);
+    for (auto frame = decoder->spareFrames; frame; frame = frame->next)
+        freed += sizeof(H264Frame) + frame->capacity;
+    freeSpareH264Frames(decoder);
+
+    if (decoder->pending == 0) {
+        freed += (decoder->fullFrame.capacity + decoder->downsampleScratch.capacity) * sizeof(uint32_t);
+        freeScratch(&decoder->fullFrame);
+        freeScratch(&decoder->downsampleScratch);
+    }
+    UNLOCK(decoder->mutex);
+    return freed;
+}
+
+void freeH264Decoder(H264Decoder *decoder) {
+    if (!decoder)
+        return;
+
+    LOCK(decoder->mutex);
+    decoder->quit = true;
+    pthread_cond_broadcast(&decoder->cond);
+    UNLOCK(decoder->mutex);
+
+    pthread_join(decoder->thread, nullptr);
+    stopPainters(decoder);
+
+    log_info("H.264: %llu frames, %llu bytes, %llu ms decode time",
+             (unsigned long long) decoder->framesDecoded,
+             (unsigned long long) decoder->bytesReceived,
+             (unsigned long long) decoder->decodeTimeUs / 1000);
+    log_info("H.264: %d painters, %llu frames painted in parallel, %llu ms paint time",
+             decoder->painterCount,
+             (unsigned long long) decoder->framesPaintedInParallel,
+             (unsigned long long) decoder->paintTimeUs / 1000);
+
+    while (decoder->head) {
+        auto frame = decoder->head;
+        decoder->head = frame->next;
+        freeH264Frame(frame);
+    }
+    freeSpareH264Frames(decoder);
+
+    freeScratch(&decoder->fullFrame);
+    freeScratch(&decoder->downsampleScratch);
+    pthread_cond_destroy(&decoder->cond);
+    TINI_MUTEX(decoder->mutex);
+    free(decoder);
+}
+
+#endif //AVNC_H264DECODER_H
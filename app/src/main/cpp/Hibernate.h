@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_HIBERNATE_H
+#define AVNC_HIBERNATE_H
+
+#include <pthread.h>
+#include <unistd.h>
+#include <zlib.h>
+#include <rfb/rfbclient.h>
+#include "ClientEx.h"
+#include "Utility.h"
+
+/**
+ * Framebuffer hibernation
+ *
+ * When updates have been paused for a while (i.e. session is in background), the
+ * framebuffer is compressed into a much smaller buffer, and original is freed.
+ * This reduces our memory footprint, and the chances of being killed by Android.
+ *
+ * Framebuffer is compressed in horizontal bands, using multiple threads. When the
+ * framebuffer is needed again (new message from server, or rendering), it is
+ * restored, again using multiple threads.
+ *
+ * Hibernation is done on the receiver thread, which is the only one modifying the
+ * framebuffer. Both hibernation & restoration is done while holding ex->mutex.
+ */
+
+static const uint64_t HibernateDelayUs = 30 * 1000 * 1000;
+static const int HibernateBandRows = 64;
+static const int HibernateMaxThreads = 4;
+
+struct HibernatedBand {
+    uint8_t *data;
+    uLongf size;
+};
+
+struct HibernatedFrameBuffer {
+    int width;
+    int height;
+    size_t rawSize;
+    int bandCount;
+    HibernatedBand *bands;
+};
+
+/**
+ * Each worker processes every [step]th band, starting from [first].
+ */
+struct HibernateWork {
+    HibernatedFrameBuffer *hfb;
+    uint8_t *frameBuffer;
+    int first;
+    int step;
+    bool success;
+};
+
+static size_t getBandOffset(HibernatedFrameBuffer *hfb, int band) {
+    return (size_t) band * HibernateBandRows * hfb->width * 4;
+}
+
+static size_t getBandSize(HibernatedFrameBuffer *hfb, int band) {
+    int rows = hfb->height - band * HibernateBandRows;
+    if (rows > HibernateBandRows) rows = HibernateBandRows;
+    return (size_t) rows * hfb->width * 4;
+}
+
+static void *compressBands(void *arg) {
+    auto work = (HibernateWork *) arg;
+    auto hfb = work->hfb;
+
+    for (int i = work->first; i < hfb->bandCount && work->success; i += work->step) {
+        auto src = work->frameBuffer + getBandOffset(hfb, i);
+        auto srcSize = getBandSize(hfb, i);
+        auto band = &hfb->bands[i];
+
+        band->size = compressBound(srcSize);
+        band->data = (uint8_t *) malloc(band->size);
+        if (!band->data || compress2(band->data, &band->size, src, srcSize, Z_BEST_SPEED) != Z_OK) {
+            work->success = false;
+            break;
+        }
+
+        // Trim the excess
+        auto trimmed = (uint8_t *) realloc(band->data, band->size);
+        if (trimmed) band->data = trimmed;
+    }
+    return nullptr;
+}
+
+static void *decompressBands(void *arg) {
+    auto work = (HibernateWork *) arg;
+    auto hfb = work->hfb;
+
+    for (int i = work->first; i < hfb->bandCount && work->success; i += work->step) {
+        auto dst = work->frameBuffer + getBandOffset(hfb, i);
+        uLongf dstSize = getBandSize(hfb, i);
+        auto band = &hfb->bands[i];
+
+        if (uncompress(dst, &dstSize, band->data, band->size) != Z_OK || dstSize != getBandSize(hfb, i))
+            work->success = false;
+    }
+    return nullptr;
+}
+
+/**
+ * Runs [routine] on multiple threads, including the calling thread.
+ * Returns true if all workers succeeded.
+ */
+static bool runHibernateWork(void *(*routine)(void *), HibernatedFrameBuffer *hfb, uint8_t *frameBuffer) {
+    long cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+    int threadCount = cpuCount < 1 ? 1 : (cpuCount > HibernateMaxThreads ? HibernateMaxThreads : (int) cpuCount);
+    if (threadCount > hfb->bandCount) threadCount = hfb->bandCount;
+
+    HibernateWork work[HibernateMaxThreads];
+    pthread_t threads[HibernateMaxThreads];
+    bool started[HibernateMaxThreads] = {};
+
+    for (int i = 0; i < threadCount; ++i)
+        work[i] = {hfb, frameBuffer, i, threadCount, true};
+
+    for (int i = 1; i < threadCount; ++i)
+        started[i] = pthread_create(&threads[i], nullptr, routine, &work[i]) == 0;
+
+    routine(&work[0]);
+
+    // Do the work of workers which couldn't be started
+    for (int i = 1; i < threadCount; ++i) {
+        if (started[i]) pthread_join(threads[i], nullptr);
+        else routine(&work[i]);
+    }
+
+    bool success = true;
+    for (int i = 0; i < threadCount; ++i)
+        success = success && work[i].success;
+    return success;
+}
+
+static void freeHibernatedFrameBuffer(HibernatedFrameBuffer *hfb) {
+    if (!hfb)
+        return;
+
+    for (int i = 0; i < hfb->bandCount; ++i)
+        free(hfb->bands[i].data);
+    free(hfb->bands);
+    free(hfb);
+}
+
+/**
+ * Compresses the framebuffer, and frees the original.
+ * Must be called from receiver thread.
+ */
+static void hibernateFrameBuffer(rfbClient *client) {
+    auto ex = getClientExtension(client);
+
+    LOCK(ex->mutex);
+
+    if (ex->hibernated || !client->frameBuffer || ex->fbRealWidth <= 0 || ex->fbRealHeight <= 0) {
+        UNLOCK(ex->mutex);
+        return;
+    }
+
+    // Pending JPEG rects would be missing from the snapshot, and their data would stay in memory
+    LazyJpegTarget fb = {(uint32_t *) client->frameBuffer, ex->fbRealWidth, ex->fbRealHeight, ex->fbShift,
+                         &ex->detail};
+    flushLazyJpegs(&ex->jpeg, &ex->uploads, fb);
+
+    auto hfb = (HibernatedFrameBuffer *) malloc(sizeof(HibernatedFrameBuffer));
+    if (hfb) {
+        hfb->width = ex->fbRealWidth;
+        hfb->height = ex->fbRealHeight;
+        hfb->rawSize = (size_t) hfb->width * hfb->height * 4;
+        hfb->bandCount = (hfb->height + HibernateBandRows - 1) / HibernateBandRows;
+        hfb->bands = (HibernatedBand *) calloc(hfb->bandCount, sizeof(HibernatedBand));
+    }
+
+    auto start = monotonicTimeUs();
+    if (hfb && hfb->bands && runHibernateWork(compressBands, hfb, client->frameBuffer)) {
+        size_t compressedSize = 0;
+        for (int i = 0; i < hfb->bandCount; ++i)
+            compressedSize += hfb->bands[i].size;
+
+        free(client->frameBuffer);
+        client->frameBuffer = nullptr;
+        ex->hibernated = hfb;
+
+        // Renderer requests it again after restore
+        releaseFrameDetailLocked(&ex->detail);
+
+        log_info("Framebuffer hibernated in %llums: %zu -> %zu bytes",
+                 (unsigned long long) (monotonicTimeUs() - start) / 1000, hfb->rawSize, compressedSize);
+    } else {
+        log_error("Framebuffer hibernation failed");
+        if (hfb) freeHibernatedFrameBuffer(hfb);
+    }
+
+    UNLOCK(ex->mutex);
+}
+
+/**
+ * Restores hibernated framebuffer, if any.
+ * Must be called with ex->mutex held.
+ * Returns false if framebuffer could not be restored.
+ */
+static bool restoreFrameBufferLocked(rfbClient *client) {
+    auto ex = getClientExtension(client);
+    auto hfb = ex->hibernated;
+
+    if (!hfb)
+        return true;
+
+    auto frameBuffer = (uint8_t *) malloc(hfb->rawSize);
+    if (!frameBuffer) {
+        log_error("Framebuffer restore failed: not enough memory");
+        return false;
+    }
+
+    auto start = monotonicTimeUs();
+    if (!runHibernateWork(decompressBands, hfb, frameBuffer)) {
+        // Should never happen, but just in case.
+        // Cleared framebuffer is better than garbage.
+        log_error("Framebuffer restore failed: corrupted data");
+        memset(frameBuffer, 0, hfb->rawSize);
+    }
+
+    client->frameBuffer = frameBuffer;
+    ex->hibernated = nullptr;
+    log_info("Framebuffer restored in %llums", (unsigned long long) (monotonicTimeUs() - start) / 1000);
+
+    freeHibernatedFrameBuffer(hfb);
+    return true;
+}
+
+static bool restoreFrameBuffer(rfbClient *client) {
+    auto ex = getClientExtension(client);
+    LOCK(ex->mutex);
+    auto result = restoreFrameBufferLocked(client);
+    UNLOCK(ex->mutex);
+    return result;
+}
+
+/**
+ * Hibernates the framebuffer if updates have been paused for long enough.
+ * Must be called from receiver thread.
+ */
+static void hibernateIfIdle(rfbClient *client) {
+    auto ex = getClientExtension(client);
+    if (!ex->hibernated && getPausedDurationUs(&ex->background) >= HibernateDelayUs)
+        hibernateFrameBuffer(client);
+}
+
+#endif //AVNC_HIBERNATE_H
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_KERNELS_H
+#define AVNC_KERNELS_H
+
+#include "CpuFeatures.h"
+#include "ColorConvert.h"
+#include "Cursor.h"
+#include "Downsample.h"
+#include "PixelWriter.h"
+#include "Utility.h"
+
+/**
+ * Binds pixel kernels (see CpuFeatures.h) for given features.
+ * Scalar references are the fallback for everything.
+ * Returns name of the widest variant bound, for logging.
+ */
+static const char *bindPixelKernels(PixelKernels *k, const CpuFeatures &features) {
+    const char *variant = "scalar";
+    k->fillRow = fillRowScalar;
+    k->yuvRowToBGRX = yuvRowToBGRXScalar;
+    k->blendCursorRow = blendCursorRowScalar;
+    k->averageRows = averageRowsScalar;
+    k->halveRow = halveRowScalar;
+
+#if defined(__ARM_NEON)
+    // On 32-bit ARM, NEON is enabled at compile time, but a few old devices don't have it.
+    // SVE & dot product are detected for diagnostics only; none of the kernels benefit from them.
+    if (features.neon) {
+        variant = "neon";
+        k->yuvRowToBGRX = yuvRowToBGRXNeon;
+        k->blendCursorRow = blendCursorRowNeon;
+        k->averageRows = averageRowsNeon;
+        k->halveRow = halveRowNeon;
+    }
+#elif defined(__SSE2__)
+    // SSE2 is part of both x86 ABIs
+    variant = "sse2";
+    k->yuvRowToBGRX = yuvRowToBGRXSSE2;
+    k->blendCursorRow = blendCursorRowSSE2;
+    k->averageRows = averageRowsSSE2;
+    k->halveRow = halveRowSSE2;
+#endif
+
+#if defined(AVNC_AVX2_KERNELS)
+    // Color conversion stays on SSE2. Its chroma shuffles would cross
+    // 128-bit lanes, which costs more than the wider registers save.
+    if (features.avx2) {
+        variant = "avx2";
+        k->fillRow = fillRowAVX2;
+        k->blendCursorRow = blendCursorRowAVX2;
+        k->averageRows = averageRowsAVX2;
+        k->halveRow = halveRowAVX2;
+    }
+#endif
+
+    return variant;
+}
+
+/**
+ * Detects CPU features & binds the kernel table. Called from JNI_OnLoad.
+ */
+static void initPixelKernels() {
+    detectCpuFeatures(&cpuFeatures);
+    auto variant = bindPixelKernels(&kernels, cpuFeatures);
+
+    log_info("CPU features:%s%s%s%s%s, kernels: %s",
+             cpuFeatures.neon ? " neon" : "",
+             cpuFeatures.dotprod ? " dotprod" : "",
+             cpuFeatures.sve ? " sve" : "",
+             cpuFeatures.sse41 ? " sse4.1" : "",
+             cpuFeatures.avx2 ? " avx2" : "",
+             variant);
+}
+
+#endif //AVNC_KERNELS_H
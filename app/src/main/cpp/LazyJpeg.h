@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_LAZYJPEG_H
+#define AVNC_LAZYJPEG_H
+
+#include <turbojpeg.h>
+#include <rfb/rfbclient.h>
+#include "UploadPlanner.h"
+#include "Downsample.h"
+#include "FrameDetail.h"
+
+/**
+ * Lazy decoding of Tight JPEG rectangles.
+ *
+ * When zoomed in, most of the framebuffer is off-screen, but every JPEG
+ * rectangle received from server is still decoded. Unlike zlib-based data,
+ * JPEG rectangles are self-contained, so decoding of off-screen rectangles
+ * can be postponed until the viewport moves over them.
+ *
+ * LibVNCClient hands us the compressed data through GotJpeg hook. If the
+ * rectangle is outside the viewport (plus a margin), a copy of the data is
+ * kept. Otherwise, it is decoded straight into the framebuffer.
+ *
+ * Pending rectangles never overlap each other, so they can be decoded in any
+ * order. Before anything else writes to the framebuffer, pending rectangles
+ * in that area are resolved:
+ *  - Rectangles completely overwritten by the write are dropped.
+ *  - Partially overwritten rectangles (and any rectangle read by CopyRect)
+ *    are decoded first.
+ *
+ * Lock order: framebuffer lock (if held) -> LazyJpeg::mutex -> planner lock.
+ */
+
+// Rectangles within this distance of the viewport are decoded immediately,
+// so that they are ready when user pans a little.
+static const int LazyJpegViewportMargin = UploadTileSize;
+
+// Max compressed bytes kept around. Oldest rectangles are decoded beyond this.
+static const size_t LazyJpegMaxPendingBytes = 16 * 1024 * 1024;
+
+// Resolved rectangles are kept for reuse, up to this many bytes
+static const size_t LazyJpegMaxSpareBytes = 1024 * 1024;
+
+struct LazyJpegRect {
+    UploadRect r;
+    uint32_t length;
+    uint32_t capacity;
+    uint8_t *data;
+    LazyJpegRect *next;
+};
+
+struct LazyJpeg {
+    // Created on first use
+    tjhandle decompressor;
+
+    // Pending rectangles, oldest first
+    LazyJpegRect *head;
+    LazyJpegRect *tail;
+    int pendingCount; // Read without lock by writers, to skip locking when nothing is pending
+    size_t pendingBytes;
+
+    // Rectangles available for reuse
+    LazyJpegRect *spare;
+    size_t spareBytes;
+
+    // Last viewport reported by renderer, in server coordinates. Empty if not known yet.
+    UploadRect viewport;
+
+    // Used when a rectangle in full resolution region of a downsampled framebuffer is decoded
+    ScratchBuffer fullScratch;
+    ScratchBuffer downsampleScratch;
+
+    // Stats
+    uint64_t deferredCount;
+    uint64_t decodedLaterCount;
+    uint64_t supersededCount;
+
+    MUTEX(mutex);
+};
+
+static void initLazyJpeg(LazyJpeg *lj) {
+    lj->decompressor = nullptr;
+    lj->head = nullptr;
+    lj->tail = nullptr;
+    lj->pendingCount = 0;
+    lj->pendingBytes = 0;
+    lj->spare = nullptr;
+    lj->spareBytes = 0;
+    lj->viewport = {0, 0, 0, 0};
+    lj->fullScratch = {nullptr, 0};
+    lj->downsampleScratch = {nullptr, 0};
+    lj->deferredCount = 0;
+    lj->decodedLaterCount = 0;
+    lj->supersededCount = 0;
+    INIT_MUTEX(lj->mutex);
+}
+
+/**
+ * Rounds rect capacity up to a few discrete sizes (4 per power of two, so at
+ * most 25% is wasted), so that spare rects fit rectangles of similar size.
+ */
+static uint32_t lazyJpegRectCapacity(uint32_t length) {
+    if (length <= 4096)
+        return 4096;
+    if (length >= (1u << 31))
+        return length;
+
+    uint32_t step = 1u << (31 - __builtin_clz(length));
+    step /= 4;
+    return (length + step - 1) / step * step;
+}
+
+/**
+ * Returns a rect with space for [length] bytes, reusing a spare one if possible.
+ */
+static LazyJpegRect *acquireLazyJpegRect(LazyJpeg *lj, uint32_t length) {
+    LazyJpegRect *prev = nullptr;
+    for (auto rect = lj->spare; rect; prev = rect, rect = rect->next) {
+        if (rect->capacity >= length) {
+            if (prev) prev->next = rect->next;
+            else lj->spare = rect->next;
+            lj->spareBytes -= rect->capacity;
+            return rect;
+        }
+    }
+
+    auto rect = (LazyJpegRect *) malloc(sizeof(LazyJpegRect));
+    if (rect) {
+        rect->capacity = lazyJpegRectCapacity(length);
+        rect->data = (uint8_t *) malloc(rect->capacity);
+        if (!rect->data) {
+            free(rect);
+            rect = nullptr;
+        }
+    }
+    return rect;
+}
+
+static void freeSpareLazyJpegRects(LazyJpeg *lj) {
+    while (lj->spare) {
+        auto rect = lj->spare;
+        lj->spare = rect->next;
+        free(rect->data);
+        free(rect);
+    }
+    lj->spareBytes = 0;
+}
+
+/**
+ * Removes a resolved rect from accounting, and keeps it for reuse.
+ */
+static void freeLazyJpegRect(LazyJpeg *lj, LazyJpegRect *rect) {
+    lj->pendingBytes -= rect->length;
+    __atomic_store_n(&lj->pendingCount, lj->pendingCount - 1, __ATOMIC_RELAXED);
+
+    if (lj->spareBytes + rect->capacity > LazyJpegMaxSpareBytes) {
+        free(rect->data);
+        free(rect);
+        return;
+    }
+    rect->next = lj->spare;
+    lj->spare = rect;
+    lj->spareBytes += rect->capacity;
+}
+
+/**
+ * Removes given rect from the list. [prev] is the rect before it, or nullptr.
+ */
+static void unlinkLazyJpegRect(LazyJpeg *lj, LazyJpegRect *prev, LazyJpegRect *rect) {
+    if (prev) prev->next = rect->next;
+    else lj->head = rect->next;
+    if (lj->tail == rect) lj->tail = prev;
+}
+
+static void dropLazyJpegsLocked(LazyJpeg *lj) {
+    while (lj->head) {
+        auto rect = lj->head;
+        lj->head = rect->next;
+        freeLazyJpegRect(lj, rect);
+    }
+    lj->tail = nullptr;
+}
+
+/**
+ * Forgets all pending rectangles. Used when framebuffer is reallocated.
+ */
+static void dropLazyJpegs(LazyJpeg *lj) {
+    LOCK(lj->mutex);
+    dropLazyJpegsLocked(lj);
+    UNLOCK(lj->mutex);
+}
+
+static void destroyLazyJpeg(LazyJpeg *lj) {
+    if (lj->deferredCount)
+        log_info("Lazy JPEG: %llu rects deferred, %llu decoded later, %llu superseded",
+                 (unsigned long long) lj->deferredCount, (unsigned long long) lj->decodedLaterCount,
+                 (unsigned long long) lj->supersededCount);
+
+    dropLazyJpegsLocked(lj);
+    freeSpareLazyJpegRects(lj);
+    freeScratch(&lj->fullScratch);
+    freeScratch(&lj->downsampleScratch);
+    if (lj->decompressor)
+        tjDestroy(lj->decompressor);
+    TINI_MUTEX(lj->mutex);
+}
+
+/**
+ * Framebuffer being decoded into. Passed explicitly because receiver thread
+ * & renderer thread have different views of the framebuffer size.
+ * Rectangles are kept in server coordinates, [shift] maps them to framebuffer.
+ * Parts falling in full resolution region of [detail] are also written there.
+ */
+struct LazyJpegTarget {
+    uint32_t *frameBuffer;
+    int width;
+    int height;
+    int shift;
+    FrameDetail *detail;
+};
+
+/**
+ * Decodes JPEG data into given rect of the framebuffer.
+ * Must be called with lj->mutex held.
+ */
+static bool decodeJpegLocked(LazyJpeg *lj, LazyJpegTarget fb, const uint8_t *data, uint32_t length, UploadRect r) {
+    auto target = scaleRectDown(r, fb.shift);
+    if (!fb.frameBuffer || r.x < 0 || r.y < 0 || r.w <= 0 || r.h <= 0 ||
+        target.x + target.w > fb.width || target.y + target.h > fb.height)
+        return false;
+
+    if (!lj->decompressor) {
+        lj->decompressor = tjInitDecompress();
+        if (!lj->decompressor) {
+            rfbClientErr("Lazy JPEG: Could not create decompressor\n");
+            return false;
+        }
+    }
+
+    int width, height, subsamp, colorspace;
+    if (tjDecompressHeader3(lj->decompressor, data, length, &width, &height, &subsamp, &colorspace) != 0 ||
+        width != r.w || height != r.h) {
+        rfbClientErr("Lazy JPEG: Invalid JPEG header\n");
+        return false;
+    }
+
+    // Inside full resolution region, rect is decoded at full resolution, and downsampled from there
+    if (fb.shift && fb.detail && isFrameDetailActive(fb.detail) && rectsIntersect(r, fb.detail->rect)) {
+        auto full = reserveScratch(&lj->fullScratch, (size_t) r.w * r.h);
+        if (!full)
+            return false;
+        if (tjDecompress2(lj->decompressor, data, length, (uint8_t *) full, r.w, r.w * (int) sizeof(uint32_t), r.h,
+                          TJPF_BGRX, TJFLAG_FASTDCT) != 0) {
+            rfbClientErr("Lazy JPEG: %s\n", tjGetErrorStr2(lj->decompressor));
+            return false;
+        }
+        writeFrameDetail(fb.detail, full, r.w, r);
+        return downsampleBlock(fb.frameBuffer, fb.width, full, r.w, r.x, r.y, r.w, r.h, fb.shift,
+                               &lj->downsampleScratch);
+    }
+
+    // For a downsampled framebuffer, TurboJPEG's scaled IDCT does the downsampling,
+    // as it picks scaling factor of 1/2^shift for these dimensions.
+    auto dst = (uint8_t *) (fb.frameBuffer + (size_t) target.y * fb.width + target.x);
+    auto pitch = fb.width * (int) sizeof(uint32_t);
+    auto dstW = scaledLength(r.w, fb.shift);
+    auto dstH = scaledLength(r.h, fb.shift);
+    if (tjDecompress2(lj->decompressor, data, length, dst, dstW, pitch, dstH, TJPF_BGRX, TJFLAG_FASTDCT) != 0) {
+        rfbClientErr("Lazy JPEG: %s\n", tjGetErrorStr2(lj->decompressor));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Decodes a pending rect and frees it. It must already be unlinked.
+ */
+static void decodePendingLocked(LazyJpeg *lj, UploadPlanner *planner, LazyJpegTarget fb, LazyJpegRect *rect) {
+    if (decodeJpegLocked(lj, fb, rect->data, rect->length, rect->r)) {
+        auto damage = scaleRectDown(rect->r, fb.shift);
+        markDamage(planner, damage.x, damage.y, damage.w, damage.h);
+        lj->decodedLaterCount++;
+    }
+    freeLazyJpegRect(lj, rect);
+}
+
+/**
+ * Resolves pending rectangles intersecting [area], before it is accessed.
+ * If [overwrite] is true, [area] is about to be overwritten, so rectangles
+ * lying completely inside it are simply dropped.
+ */
+static void resolveLazyJpegsLocked(LazyJpeg *lj, UploadPlanner *planner, LazyJpegTarget fb,
+                                   UploadRect area, bool overwrite) {
+    LazyJpegRect *prev = nullptr;
+    auto rect = lj->head;
+
+    while (rect) {
+        auto next = rect->next;
+        if (rectsIntersect(area, rect->r)) {
+            unlinkLazyJpegRect(lj, prev, rect);
+            if (overwrite && rectContains(area, rect->r)) {
+                lj->supersededCount++;
+                freeLazyJpegRect(lj, rect);
+            } else {
+                decodePendingLocked(lj, planner, fb, rect);
+            }
+        } else {
+            prev = rect;
+        }
+        rect = next;
+    }
+}
+
+static inline bool hasPendingJpegs(LazyJpeg *lj) {
+    return __atomic_load_n(&lj->pendingCount, __ATOMIC_RELAXED) != 0;
+}
+
+static void resolveLazyJpegs(LazyJpeg *lj, UploadPlanner *planner, LazyJpegTarget fb,
+                             UploadRect area, bool overwrite) {
+    if (!hasPendingJpegs(lj))
+        return;
+
+    LOCK(lj->mutex);
+    resolveLazyJpegsLocked(lj, planner, fb, area, overwrite);
+    UNLOCK(lj->mutex);
+}
+
+static bool isNearViewport(LazyJpeg *lj, UploadRect r) {
+    auto v = lj->viewport;
+    if (v.w <= 0 || v.h <= 0)
+        return true;
+
+    UploadRect expanded = {v.x - LazyJpegViewportMargin, v.y - LazyJpegViewportMargin,
+                           v.w + 2 * LazyJpegViewportMargin, v.h + 2 * LazyJpegViewportMargin};
+    return rectsIntersect(expanded, r);
+}
+
+/**
+ * Handles a JPEG rectangle received from server.
+ * Returns false if it could not be decoded.
+ */
+static bool handleJpegRect(LazyJpeg *lj, UploadPlanner *planner, LazyJpegTarget fb,
+                           const uint8_t *data, int length, UploadRect r) {
+    bool success = true;
+    LOCK(lj->mutex);
+
+    resolveLazyJpegsLocked(lj, planner, fb, r, true);
+
+    LazyJpegRect *rect = nullptr;
+    if (!isNearViewport(lj, r))
+        rect = acquireLazyJpegRect(lj, (uint32_t) length);
+
+    if (rect) {
+        memcpy(rect->data, data, length);
+        rect->r = r;
+        rect->length = (uint32_t) length;
+        rect->next = nullptr;
+        if (lj->tail) lj->tail->next = rect;
+        else lj->head = rect;
+        lj->tail = rect;
+        lj->pendingBytes += rect->length;
+        __atomic_store_n(&lj->pendingCount, lj->pendingCount + 1, __ATOMIC_RELAXED);
+        lj->deferredCount++;
+
+        while (lj->pendingBytes > LazyJpegMaxPendingBytes && lj->head != rect) {
+            auto oldest = lj->head;
+            unlinkLazyJpegRect(lj, nullptr, oldest);
+            decodePendingLocked(lj, planner, fb, oldest);
+        }
+    } else {
+        success = decodeJpegLocked(lj, fb, data, (uint32_t) length, r);
+    }
+
+    UNLOCK(lj->mutex);
+    return success;
+}
+
+/**
+ * Decodes all pending rectangles. Used before the framebuffer is snapshotted
+ * (e.g. for hibernation), so that the snapshot is complete.
+ * Must be called with framebuffer lock held.
+ */
+static void flushLazyJpegs(LazyJpeg *lj, UploadPlanner *planner, LazyJpegTarget fb) {
+    if (!hasPendingJpegs(lj))
+        return;
+
+    LOCK(lj->mutex);
+    while (lj->head) {
+        auto rect = lj->head;
+        unlinkLazyJpegRect(lj, nullptr, rect);
+        decodePendingLocked(lj, planner, fb, rect);
+    }
+    UNLOCK(lj->mutex);
+}
+
+/**
+ * Records current viewport (in framebuffer coordinates), and decodes pending
+ * rectangles near it. Called from renderer thread, with framebuffer lock held.
+ *
+ * Decoding counts against renderer's upload budget: it stops at [deadlineUs],
+ * after at least one rectangle. Returns true if rectangles near the viewport
+ * are still pending, in which case renderer should call again in next frame.
+ */
+static bool updateLazyJpegViewport(LazyJpeg *lj, UploadPlanner *planner, LazyJpegTarget fb, UploadRect viewport,
+                                   uint64_t deadlineUs) {
+    LOCK(lj->mutex);
+    lj->viewport = scaleRectUp(viewport, fb.shift);
+
+    bool outOfTime = false, pending = false;
+    LazyJpegRect *prev = nullptr;
+    auto rect = lj->head;
+    while (rect) {
+        auto next = rect->next;
+        if (isNearViewport(lj, rect->r)) {
+            if (outOfTime) {
+                pending = true;
+                break;
+            }
+            unlinkLazyJpegRect(lj, prev, rect);
+            decodePendingLocked(lj, planner, fb, rect);
+            outOfTime = monotonicTimeUs() >= deadlineUs;
+        } else {
+            prev = rect;
+        }
+        rect = next;
+    }
+    UNLOCK(lj->mutex);
+    return pending;
+}
+
+#endif //AVNC_LAZYJPEG_H
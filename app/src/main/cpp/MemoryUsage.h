@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_MEMORYUSAGE_H
+#define AVNC_MEMORYUSAGE_H
+
+#include <rfb/rfbclient.h>
+#include "ClientEx.h"
+#include "H264Decoder.h"
+#include "Hibernate.h"
+
+/**
+ * Native memory accounting & trimming.
+ *
+ * Reports native memory held by a session, grouped in categories. Buffers we
+ * allocate are counted exactly. Memory hidden inside other libraries is
+ * estimated:
+ *  - zlib inflate streams (used by Zlib, ZRLE & Tight encodings)
+ *  - TurboJPEG decompressor
+ *  - TLS session
+ * Memory of MediaCodec instances mostly lives outside our process, and is
+ * not counted.
+ *
+ * When Android signals memory pressure, a trim is requested. Most of the
+ * trimmable buffers are owned by receiver thread, so trim is done by receiver
+ * thread when it processes next message (or times out waiting for one).
+ * Everything freed here is allocated again on demand.
+ */
+
+enum MemoryCategory {
+    MemFrameBuffer,  // Framebuffer
+    MemHibernated,   // Compressed framebuffer, while hibernated
+    MemCursor,       // Cursor pixels & composition buffer
+    MemScratch,      // Reusable scratch buffers
+    MemDecoderState, // Decoder buffers & stream states
+    MemQueues,       // Data waiting to be decoded
+    MemTls,          // TLS session
+    MemBookkeeping,  // Client structs, damage tracking etc.
+    MemCategoryCount
+};
+
+// Estimates, see above. InflateStreamEstimate is in ZlibStreams.h.
+static const size_t TurboJpegHandleEstimate = 32 * 1024;
+static const size_t TlsSessionEstimate = 48 * 1024; // Record buffers + state
+
+// Values for ClientEx::trimRequest
+static const int TrimCaches = 1;     // Free scratch buffers & idle decoder state
+static const int TrimAggressive = 2; // Also hibernate framebuffer if updates are paused
+
+static size_t relaxedLoad(const size_t &value) {
+    return __atomic_load_n(&value, __ATOMIC_RELAXED);
+}
+
+/**
+ * Collects memory usage of given client. Can be called from any thread.
+ */
+static void getMemoryUsage(rfbClient *client, size_t usage[MemCategoryCount]) {
+    auto ex = getClientExtension(client);
+    for (int i = 0; i < MemCategoryCount; ++i)
+        usage[i] = 0;
+
+    LOCK(ex->mutex);
+    {
+        if (client->frameBuffer)
+            usage[MemFrameBuffer] = (size_t) ex->fbRealWidth * ex->fbRealHeight * 4;
+        if (isFrameDetailActive(&ex->detail))
+            usage[MemFrameBuffer] += (size_t) ex->detail.rect.w * ex->detail.rect.h * 4;
+
+        if (auto hfb = ex->hibernated) {
+            usage[MemHibernated] = sizeof(HibernatedFrameBuffer) + hfb->bandCount * sizeof(HibernatedBand);
+            for (int i = 0; i < hfb->bandCount; ++i)
+                usage[MemHibernated] += hfb->bands[i].size;
+        }
+
+        Cursor *cursors[] = {ex->cursor, ex->detail.cursor};
+        for (auto cursor: cursors)
+            if (cursor)
+                usage[MemCursor] += sizeof(Cursor) + (cursor->pixels.capacity + cursor->scratch.capacity) * PixelBytes;
+
+        // Planner scratch is only modified under ex->mutex
+        usage[MemScratch] += (ex->uploads.scratchSize + ex->detail.uploads.scratchSize) * sizeof(uint32_t);
+    }
+    UNLOCK(ex->mutex);
+
+    // Buffers owned by receiver thread. Reads can be slightly stale.
+    usage[MemScratch] += relaxedLoad(ex->fbScratch.capacity) * sizeof(uint32_t);
+    usage[MemCursor] += (relaxedLoad(ex->cursorShape.capacity) + relaxedLoad(ex->cursorScaled.capacity)) * PixelBytes;
+    usage[MemDecoderState] += (size_t) __atomic_load_n(&client->raw_buffer_size, __ATOMIC_RELAXED);
+    usage[MemDecoderState] += (size_t) __atomic_load_n(&client->ultra_buffer_size, __ATOMIC_RELAXED);
+
+    usage[MemDecoderState] += __atomic_load_n(&ex->zlibStreams.parkedBytes, __ATOMIC_RELAXED);
+    if (__atomic_load_n(&client->decompStreamInited, __ATOMIC_RELAXED))
+        usage[MemDecoderState] += InflateStreamEstimate;
+    for (int i = 0; i < 4; ++i)
+        if (__atomic_load_n(&client->zlibStreamActive[i], __ATOMIC_RELAXED))
+            usage[MemDecoderState] += InflateStreamEstimate;
+
+    if (__atomic_load_n(&client->tlsSession, __ATOMIC_RELAXED))
+        usage[MemTls] = TlsSessionEstimate;
+
+    LOCK(ex->jpeg.mutex);
+    usage[MemQueues] += ex->jpeg.pendingBytes + ex->jpeg.pendingCount * sizeof(LazyJpegRect);
+    usage[MemScratch] += ex->jpeg.spareBytes;
+    usage[MemScratch] += (ex->jpeg.fullScratch.capacity + ex->jpeg.downsampleScratch.capacity) * sizeof(uint32_t);
+    if (ex->jpeg.decompressor)
+        usage[MemDecoderState] += TurboJpegHandleEstimate;
+    UNLOCK(ex->jpeg.mutex);
+
+    if (auto h264 = __atomic_load_n(&ex->h264, __ATOMIC_ACQUIRE)) {
+        size_t queued, scratch;
+        getH264MemoryUsage(h264, &queued, &scratch);
+        usage[MemQueues] += queued;
+        usage[MemScratch] += scratch;
+        usage[MemBookkeeping] += sizeof(H264Decoder);
+    }
+
+    LOCK(ex->uploads.mutex);
+    usage[MemBookkeeping] += (size_t) ex->uploads.cols * ex->uploads.rows * (sizeof(uint64_t) + sizeof(PlannedTile));
+    UNLOCK(ex->uploads.mutex);
+
+    usage[MemBookkeeping] += sizeof(rfbClient) + sizeof(ClientEx);
+}
+
+/**
+ * Asks receiver thread to trim memory. Can be called from any thread.
+ */
+static void requestMemoryTrim(ClientEx *ex, bool aggressive) {
+    __atomic_or_fetch(&ex->trimRequest, aggressive ? TrimCaches | TrimAggressive : TrimCaches, __ATOMIC_RELAXED);
+}
+
+/**
+ * Performs pending trim request, if any.
+ * Must be called from receiver thread, outside of message handling.
+ */
+static void trimMemoryIfRequested(rfbClient *client) {
+    auto ex = getClientExtension(client);
+    auto request = __atomic_exchange_n(&ex->trimRequest, 0, __ATOMIC_RELAXED);
+    if (!request)
+        return;
+
+    size_t freed = (ex->fbScratch.capacity + ex->cursorShape.capacity + ex->cursorScaled.capacity) * sizeof(uint32_t);
+    freeScratch(&ex->fbScratch);
+    freeScratch(&ex->cursorShape);
+    freeScratch(&ex->cursorScaled);
+
+    // LibVNCClient grows these as needed, and treats nullptr like an empty buffer
+    freed += client->raw_buffer_size + client->ultra_buffer_size;
+    free(client->raw_buffer);
+    free(client->ultra_buffer);
+    client->raw_buffer = nullptr;
+    client->ultra_buffer = nullptr;
+    __atomic_store_n(&client->raw_buffer_size, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&client->ultra_buffer_size, 0, __ATOMIC_RELAXED);
+
+    LOCK(ex->jpeg.mutex);
+    freed += ex->jpeg.spareBytes;
+    freed += (ex->jpeg.fullScratch.capacity + ex->jpeg.downsampleScratch.capacity) * sizeof(uint32_t);
+    freeSpareLazyJpegRects(&ex->jpeg);
+    freeScratch(&ex->jpeg.fullScratch);
+    freeScratch(&ex->jpeg.downsampleScratch);
+    if (ex->jpeg.decompressor) {
+        tjDestroy(ex->jpeg.decompressor);
+        ex->jpeg.decompressor = nullptr;
+        freed += TurboJpegHandleEstimate;
+    }
+    UNLOCK(ex->jpeg.mutex);
+
+    if (ex->h264)
+        freed += trimH264Decoder(ex->h264);
+
+    // Parked streams are restored when next message arrives
+    freed += parkIdleZlibStreams(client, &ex->zlibStreams, 0) * InflateStreamEstimate;
+
+    LOCK(ex->mutex);
+    UploadPlanner *planners[] = {&ex->uploads, &ex->detail.uploads};
+    for (auto planner: planners) {
+        freed += planner->scratchSize * sizeof(uint32_t);
+        free(planner->scratch);
+        planner->scratch = nullptr;
+        planner->scratchSize = 0;
+    }
+    UNLOCK(ex->mutex);
+
+    log_info("Memory trim: ~%zu bytes freed", freed);
+
+    if ((request & TrimAggressive) && isUpdatesPaused(&ex->background))
+        hibernateFrameBuffer(client);
+}
+
+#endif //AVNC_MEMORYUSAGE_H
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_PIXELWRITER_H
+#define AVNC_PIXELWRITER_H
+
+#include <string.h>
+#include <rfb/rfbclient.h>
+#include "ClientEx.h"
+#include "CpuFeatures.h"
+
+/**
+ * Framebuffer writers specialised for our pixel format.
+ *
+ * All decoders in LibVNCClient finally write pixels through three hooks:
+ * GotFillRect, GotBitmap & GotCopyRect. Default implementations handle every
+ * pixel format, so they branch on bits-per-pixel on every call and copy pixel
+ * by pixel (e.g. CopyRect). But we always request 32bpp, little-endian BGRX
+ * (see nativeConfigure), so these writers only handle that layout, using
+ * row-wise memcpy/memmove.
+ *
+ * Only CopyRect is measurably faster (see PixelWriterBench.cpp), and only when
+ * the compiler doesn't vectorise the generic pixel loop. Fills & bitmaps end
+ * up as the same vectorised stores/memcpy either way. These writers mainly
+ * exist as the place where downsampling, full-resolution detail & deferred
+ * JPEG rectangles hook into framebuffer writes.
+ *
+ * JPEG rectangles are also decoded by us, straight into the framebuffer
+ * (or later, see LazyJpeg.h). So before writing, pending JPEG rectangles in
+ * the target area are resolved.
+ *
+ * They are installed once, after the pixel format is chosen. For any other
+ * format, LibVNCClient's generic writers are kept.
+ */
+
+static bool isBGRX32(const rfbPixelFormat &format) {
+    return format.bitsPerPixel == 32 && format.depth == 24 && !format.bigEndian && format.trueColour &&
+           format.redMax == 255 && format.greenMax == 255 && format.blueMax == 255 &&
+           format.redShift == 16 && format.greenShift == 8 && format.blueShift == 0;
+}
+
+static bool isValidRect(rfbClient *client, int x, int y, int w, int h) {
+    return client->frameBuffer && x >= 0 && y >= 0 && w > 0 && h > 0 &&
+           x + w <= client->width && y + h <= client->height;
+}
+
+/**
+ * Framebuffer as seen by the writers. Receiver thread is the only one
+ * modifying framebuffer size, so it doesn't need the lock for this.
+ */
+static LazyJpegTarget getWriteTarget(rfbClient *client, ClientEx *ex) {
+    return {(uint32_t *) client->frameBuffer, ex->fbRealWidth, ex->fbRealHeight, ex->fbShift, &ex->detail};
+}
+
+static LazyJpegTarget getWriteTarget(rfbClient *client) {
+    return getWriteTarget(client, getClientExtension(client));
+}
+
+/**
+ * Resolves pending JPEG rectangles before given area is written (or read).
+ * Checked here first, so that the common case doesn't cost a call.
+ */
+static inline void prepareAccess(rfbClient *client, ClientEx *ex, int x, int y, int w, int h, bool overwrite) {
+    if (hasPendingJpegs(&ex->jpeg))
+        resolveLazyJpegs(&ex->jpeg, &ex->uploads, getWriteTarget(client, ex), {x, y, w, h}, overwrite);
+}
+
+/**
+ * Fill kernel. Scalar version is auto-vectorised for the baseline ISA,
+ * so only AVX2 gets its own variant.
+ */
+static void fillRowScalar(uint32_t *dst, uint32_t colour, int count) {
+    for (int i = 0; i < count; ++i)
+        dst[i] = colour;
+}
+
+#if defined(AVNC_AVX2_KERNELS)
+
+AVNC_TARGET_AVX2
+static void fillRowAVX2(uint32_t *dst, uint32_t colour, int count) {
+    auto v = _mm256_set1_epi32((int) colour);
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_si256((__m256i *) (dst + i), v);
+    fillRowScalar(dst + i, colour, count - i);
+}
+
+#endif
+
+static void fillRectBGRX32(rfbClient *client, int x, int y, int w, int h, uint32_t colour) {
+    if (!isValidRect(client, x, y, w, h))
+        return;
+
+    auto ex = getClientExtension(client);
+    prepareAccess(client, ex, x, y, w, h, true);
+
+    auto fb = getWriteTarget(client, ex);
+    auto r = scaleRectDown({x, y, w, h}, fb.shift);
+    auto stride = (size_t) fb.width;
+    auto first = fb.frameBuffer + r.y * stride + r.x;
+
+    // Every row is stored directly. Filling the first row & replicating it
+    // reads it back for each row, and kernels.fillRow() costs an indirect call
+    // per row, which is more than AVX2 saves over the auto-vectorised loop.
+    for (int j = 0; j < r.h; ++j)
+        fillRowScalar(first + j * stride, colour, r.w);
+
+    if (fb.shift)
+        fillFrameDetail(fb.detail, {x, y, w, h}, colour);
+}
+
+static void copyBitmapBGRX32(rfbClient *client, const uint8_t *buffer, int x, int y, int w, int h) {
+    if (!isValidRect(client, x, y, w, h))
+        return;
+
+    auto ex = getClientExtension(client);
+    prepareAccess(client, ex, x, y, w, h, true);
+
+    auto fb = getWriteTarget(client, ex);
+    if (fb.shift) {
+        downsampleBlock(fb.frameBuffer, fb.width, (const uint32_t *) buffer, w, x, y, w, h, fb.shift, &ex->fbScratch);
+        writeFrameDetail(fb.detail, (const uint32_t *) buffer, w, {x, y, w, h});
+        return;
+    }
+
+    auto stride = (size_t) client->width;
+    auto dst = (uint32_t *) client->frameBuffer + y * stride + x;
+    auto rowBytes = w * sizeof(uint32_t);
+
+    if (w == client->width) {
+        memcpy(dst, buffer, rowBytes * h);
+        return;
+    }
+
+    for (int j = 0; j < h; ++j)
+        memcpy(dst + j * stride, buffer + j * rowBytes, rowBytes);
+}
+
+static void copyRectBGRX32(rfbClient *client, int srcX, int srcY, int w, int h, int dstX, int dstY) {
+    if (!isValidRect(client, srcX, srcY, w, h) || !isValidRect(client, dstX, dstY, w, h))
+        return;
+
+    auto ex = getClientExtension(client);
+    prepareAccess(client, ex, srcX, srcY, w, h, false);
+    prepareAccess(client, ex, dstX, dstY, w, h, true);
+
+    // In a downsampled framebuffer, boxes of source & destination might not
+    // line up. The copy is then off by less than a framebuffer pixel.
+    auto fb = getWriteTarget(client, ex);
+    auto from = scaleRectDown({srcX, srcY, w, h}, fb.shift);
+    auto to = scaleRectDown({dstX, dstY, w, h}, fb.shift);
+    if (to.w > from.w) to.w = from.w;
+    if (to.h > from.h) to.h = from.h;
+
+    auto stride = (size_t) fb.width;
+    auto src = fb.frameBuffer + from.y * stride + from.x;
+    auto dst = fb.frameBuffer + to.y * stride + to.x;
+    auto rowBytes = to.w * sizeof(uint32_t);
+
+    // Rows can overlap, so copy in the direction which doesn't
+    // overwrite source rows before they are copied.
+    if (to.y <= from.y) {
+        for (int j = 0; j < to.h; ++j)
+            memmove(dst + j * stride, src + j * stride, rowBytes);
+    } else {
+        for (int j = to.h - 1; j >= 0; --j)
+            memmove(dst + j * stride, src + j * stride, rowBytes);
+    }
+
+    if (fb.shift)
+        copyFrameDetail(fb.detail, fb.frameBuffer, fb.width, fb.shift, srcX, srcY, w, h, dstX, dstY);
+}
+
+static rfbBool decodeJpegBGRX32(rfbClient *client, const uint8_t *buffer, int length, int x, int y, int w, int h) {
+    if (!isValidRect(client, x, y, w, h) || length <= 0)
+        return FALSE;
+
+    auto ex = getClientExtension(client);
+    auto fb = getWriteTarget(client, ex);
+    return handleJpegRect(&ex->jpeg, &ex->uploads, fb, buffer, length, {x, y, w, h}) ? TRUE : FALSE;
+}
+
+/**
+ * Installs specialised writers if current pixel format allows it.
+ * Must be called before the pixel format is sent to server.
+ */
+static void installPixelWriters(rfbClient *client) {
+    if (!isBGRX32(client->format))
+        return;
+
+    client->GotFillRect = fillRectBGRX32;
+    client->GotBitmap = copyBitmapBGRX32;
+    client->GotCopyRect = copyRectBGRX32;
+    client->GotJpeg = decodeJpegBGRX32;
+}
+
+#endif //AVNC_PIXELWRITER_H
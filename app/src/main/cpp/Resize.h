@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_RESIZE_H
+#define AVNC_RESIZE_H
+
+#include <rfb/rfbclient.h>
+#include "Utility.h"
+
+/**
+ * Manages remote desktop resize requests.
+ *
+ * Every accepted resize makes the server re-encode whole screen, so we keep at
+ * most one SetDesktopSize request in flight. Requests made while waiting for the
+ * reply are collapsed, and only the last one is sent after the reply arrives.
+ *
+ * Reply is detected via framebuffer reallocation, which happens whenever server
+ * sends a desktop size update. If server doesn't reply within a timeout (e.g. it
+ * rejected the request without sending an update), the pending request is sent
+ * by receiver thread (see checkResizeTimeout()), and later requests are sent
+ * right away.
+ */
+
+static const uint64_t ResizeReplyTimeoutUs = 2 * 1000 * 1000;
+
+struct ResizeState {
+    // Size to be requested after current request completes, 0 if none.
+    int pendingWidth, pendingHeight;
+
+    // Currently in-flight request
+    bool inFlight;
+    int sentWidth, sentHeight;
+    uint64_t sentAtUs;
+
+    // Stats
+    int requestCount;
+    int sendCount;
+
+    MUTEX(mutex);
+};
+
+static void initResizeState(ResizeState *state) {
+    INIT_MUTEX(state->mutex);
+    state->pendingWidth = state->pendingHeight = 0;
+    state->inFlight = false;
+    state->sentWidth = state->sentHeight = 0;
+    state->sentAtUs = 0;
+    state->requestCount = state->sendCount = 0;
+}
+
+static void destroyResizeState(ResizeState *state) {
+    if (state->requestCount > 0)
+        log_info("Desktop resize: %d requested, %d sent", state->requestCount, state->sendCount);
+    TINI_MUTEX(state->mutex);
+}
+
+/**
+ * Must be called with state->mutex held.
+ */
+static rfbBool sendDesktopSizeLocked(rfbClient *client, ResizeState *state, int width, int height) {
+    state->pendingWidth = state->pendingHeight = 0;
+    state->inFlight = true;
+    state->sentWidth = width;
+    state->sentHeight = height;
+    state->sentAtUs = monotonicTimeUs();
+    state->sendCount++;
+    return SendExtDesktopSize(client, width, height);
+}
+
+/**
+ * Requests server to resize the desktop to given size.
+ * [currentWidth] & [currentHeight] represent current framebuffer size.
+ */
+static rfbBool requestDesktopSize(rfbClient *client, ResizeState *state, int width, int height,
+                                  int currentWidth, int currentHeight) {
+    rfbBool result = TRUE;
+
+    LOCK(state->mutex);
+    state->requestCount++;
+
+    if (state->inFlight && monotonicTimeUs() - state->sentAtUs < ResizeReplyTimeoutUs) {
+        state->pendingWidth = width;
+        state->pendingHeight = height;
+    } else if (width == currentWidth && height == currentHeight) {
+        state->inFlight = false;
+        state->pendingWidth = state->pendingHeight = 0;
+    } else {
+        result = sendDesktopSizeLocked(client, state, width, height);
+    }
+
+    UNLOCK(state->mutex);
+    return result;
+}
+
+/**
+ * Sends the pending request, if any, and if it differs from current size.
+ * Must be called with state->mutex held.
+ */
+static void sendPendingDesktopSizeLocked(rfbClient *client, ResizeState *state, int currentWidth, int currentHeight) {
+    auto width = state->pendingWidth;
+    auto height = state->pendingHeight;
+    if (width > 0 && height > 0 && (width != currentWidth || height != currentHeight))
+        sendDesktopSizeLocked(client, state, width, height);
+    else
+        state->pendingWidth = state->pendingHeight = 0;
+}
+
+/**
+ * Should be called when server changes the desktop size.
+ * Completes in-flight request, and sends the pending one, if any.
+ */
+static void onDesktopSizeChanged(rfbClient *client, ResizeState *state, int newWidth, int newHeight) {
+    LOCK(state->mutex);
+
+    if (state->inFlight) {
+        auto elapsedMs = (long) ((monotonicTimeUs() - state->sentAtUs) / 1000);
+        log_info("Desktop resize to %dx%d completed in %ldms (actual: %dx%d)",
+                 state->sentWidth, state->sentHeight, elapsedMs, newWidth, newHeight);
+        state->inFlight = false;
+    }
+
+    sendPendingDesktopSizeLocked(client, state, newWidth, newHeight);
+    UNLOCK(state->mutex);
+}
+
+/**
+ * Should be called periodically by receiver thread.
+ * If in-flight request has not been answered within ResizeReplyTimeoutUs, it is
+ * abandoned, and the pending request is sent. Otherwise the pending request would
+ * only go out with the next request from the app, which may never come.
+ * [currentWidth] & [currentHeight] represent current desktop size.
+ */
+static void checkResizeTimeout(rfbClient *client, ResizeState *state, int currentWidth, int currentHeight) {
+    LOCK(state->mutex);
+
+    if (state->inFlight && monotonicTimeUs() - state->sentAtUs >= ResizeReplyTimeoutUs) {
+        log_info("Desktop resize to %dx%d timed out (current: %dx%d)",
+                 state->sentWidth, state->sentHeight, currentWidth, currentHeight);
+        state->inFlight = false;
+        sendPendingDesktopSizeLocked(client, state, currentWidth, currentHeight);
+    }
+
+    UNLOCK(state->mutex);
+}
+
+#endif //AVNC_RESIZE_H
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_SCRATCH_H
+#define AVNC_SCRATCH_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * Reusable pixel buffers.
+ *
+ * Update processing should not need to allocate once a session has warmed up.
+ * So buffers needed while handling updates (decode scratch, cursor shapes etc.)
+ * are kept around, and only grown when a larger one is needed. Growth is
+ * geometric, so a slowly increasing demand (e.g. rectangles of varying sizes)
+ * settles after a few allocations.
+ *
+ * Contents are NOT preserved when buffer grows.
+ */
+struct ScratchBuffer {
+    uint32_t *data;
+    size_t capacity; // In pixels
+};
+
+/**
+ * Returns a buffer of at least [pixels] size, or nullptr if allocation fails
+ * (in which case old buffer is kept).
+ */
+static uint32_t *reserveScratch(ScratchBuffer *scratch, size_t pixels) {
+    if (pixels > scratch->capacity) {
+        auto capacity = scratch->capacity + scratch->capacity / 2;
+        if (capacity < pixels)
+            capacity = pixels;
+
+        auto data = (uint32_t *) malloc(capacity * sizeof(uint32_t));
+        if (!data)
+            return nullptr;
+
+        free(scratch->data);
+        scratch->data = data;
+        __atomic_store_n(&scratch->capacity, capacity, __ATOMIC_RELAXED); // Capacity is read for accounting
+    }
+    return scratch->data;
+}
+
+static void freeScratch(ScratchBuffer *scratch) {
+    free(scratch->data);
+    scratch->data = nullptr;
+    __atomic_store_n(&scratch->capacity, 0, __ATOMIC_RELAXED);
+}
+
+static void swapScratch(ScratchBuffer *a, ScratchBuffer *b) {
+    auto tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+#endif //AVNC_SCRATCH_H
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_SCROLL_H
+#define AVNC_SCROLL_H
+
+#include <rfb/rfbclient.h>
+
+/**
+ * Scroll wheel events are emulated with button 4-7 press/release pairs.
+ * A fling can generate hundreds of them in a short time, and sending each
+ * one separately can overwhelm slow servers.
+ *
+ * So wheel ticks are accumulated here (on UI thread), and later flushed (on
+ * sender thread) as tightly packed press/release pairs in a single write.
+ * If sender falls behind, extra ticks are dropped.
+ */
+
+// Max number of pending ticks, per axis
+static const int MaxPendingScrollTicks = 50;
+
+static const int WheelUpMask = 8;
+static const int WheelDownMask = 16;
+static const int WheelLeftMask = 32;
+static const int WheelRightMask = 64;
+
+struct ScrollAccumulator {
+    // Position & button state to be used for events
+    int x, y, buttonMask;
+
+    // Positive values represent Up/Left ticks, negative represent Down/Right.
+    int hTicks, vTicks;
+
+    MUTEX(mutex);
+};
+
+static void initScrollAccumulator(ScrollAccumulator *scroll) {
+    INIT_MUTEX(scroll->mutex);
+    scroll->x = scroll->y = scroll->buttonMask = 0;
+    scroll->hTicks = scroll->vTicks = 0;
+}
+
+static void destroyScrollAccumulator(ScrollAccumulator *scroll) {
+    TINI_MUTEX(scroll->mutex);
+}
+
+static int clampTicks(int ticks) {
+    if (ticks > MaxPendingScrollTicks) return MaxPendingScrollTicks;
+    if (ticks < -MaxPendingScrollTicks) return -MaxPendingScrollTicks;
+    return ticks;
+}
+
+/**
+ * Adds given ticks to pending ticks.
+ * Returns true if there were no pending ticks before this call, i.e. caller
+ * should schedule a flush.
+ */
+static bool queueScroll(ScrollAccumulator *scroll, int x, int y, int buttonMask, int hTicks, int vTicks) {
+    LOCK(scroll->mutex);
+    bool wasEmpty = scroll->hTicks == 0 && scroll->vTicks == 0;
+    scroll->x = x;
+    scroll->y = y;
+    scroll->buttonMask = buttonMask;
+    scroll->hTicks = clampTicks(scroll->hTicks + hTicks);
+    scroll->vTicks = clampTicks(scroll->vTicks + vTicks);
+    bool isEmpty = scroll->hTicks == 0 && scroll->vTicks == 0;
+    UNLOCK(scroll->mutex);
+
+    return wasEmpty && !isEmpty;
+}
+
+static void appendPointerEvent(uint8_t *&p, int x, int y, int mask) {
+    p[0] = rfbPointerEvent;
+    p[1] = (uint8_t) mask;
+    p[2] = (uint8_t) (x >> 8);
+    p[3] = (uint8_t) x;
+    p[4] = (uint8_t) (y >> 8);
+    p[5] = (uint8_t) y;
+    p += sz_rfbPointerEventMsg;
+}
+
+static uint8_t *appendWheelClicks(uint8_t *p, int x, int y, int buttonMask, int ticks, int positiveMask,
+                                  int negativeMask) {
+    int wheelMask = ticks > 0 ? positiveMask : negativeMask;
+    int count = ticks > 0 ? ticks : -ticks;
+
+    for (int i = 0; i < count; ++i) {
+        appendPointerEvent(p, x, y, buttonMask | wheelMask);
+        appendPointerEvent(p, x, y, buttonMask);
+    }
+    return p;
+}
+
+/**
+ * Sends all pending ticks to the server.
+ * Horizontal ticks are sent before vertical ones.
+ */
+static rfbBool flushScroll(rfbClient *client, ScrollAccumulator *scroll) {
+    LOCK(scroll->mutex);
+    int x = scroll->x > 0 ? scroll->x : 0;
+    int y = scroll->y > 0 ? scroll->y : 0;
+    int buttonMask = scroll->buttonMask;
+    int hTicks = scroll->hTicks;
+    int vTicks = scroll->vTicks;
+    scroll->hTicks = scroll->vTicks = 0;
+    UNLOCK(scroll->mutex);
+
+    // Each tick is a press/release pair
+    uint8_t buffer[MaxPendingScrollTicks * 2 * 2 * sz_rfbPointerEventMsg];
+    uint8_t *p = buffer;
+    p = appendWheelClicks(p, x, y, buttonMask, hTicks, WheelLeftMask, WheelRightMask);
+    p = appendWheelClicks(p, x, y, buttonMask, vTicks, WheelUpMask, WheelDownMask);
+
+    if (p == buffer)
+        return TRUE;
+
+    return WriteToRFBServer(client, (const char *) buffer, p - buffer);
+}
+
+#endif //AVNC_SCROLL_H
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_TEXTTYPER_H
+#define AVNC_TEXTTYPER_H
+
+#include <time.h>
+#include <rfb/rfbclient.h>
+#include "XKeySym.h"
+
+/**
+ * Types text on the server by generating key events for each character.
+ * This is used with servers which don't support clipboard (e.g. BIOS consoles).
+ *
+ * Key events are generated without involving Java, and are sent to the server in
+ * large batches, instead of one socket write per event. Sending can be paced to a
+ * given rate, because some servers drop keys if they arrive too quickly.
+ */
+
+// Max number of events in a single batch
+static const int TypeTextBatchSize = 512;
+
+// Interval between batches when typing is rate-limited
+static const long TypeTextTickNs = 10 * 1000 * 1000;
+
+struct KeyEventBatch {
+    rfbKeyEventMsg events[TypeTextBatchSize];
+    int count;
+};
+
+static void appendKeyEvent(KeyEventBatch *batch, uint32_t keySym, bool down) {
+    rfbKeyEventMsg *event = &batch->events[batch->count++];
+    event->type = rfbKeyEvent;
+    event->down = down ? 1 : 0;
+    event->pad = 0;
+    event->key = rfbClientSwap32IfLE(keySym);
+}
+
+static bool flushKeyEvents(rfbClient *client, KeyEventBatch *batch) {
+    auto size = batch->count * sz_rfbKeyEventMsg;
+    batch->count = 0;
+    return size == 0 || WriteToRFBServer(client, (const char *) batch->events, size);
+}
+
+/**
+ * Decodes next code point from UTF-8 text, and advances [p] past it.
+ * Returns 0 for invalid sequences.
+ */
+static uint32_t nextCodePoint(const uint8_t *&p, const uint8_t *end) {
+    uint32_t c = *p++;
+    int extra;
+
+    if (c < 0x80) return c;
+    else if ((c & 0xe0) == 0xc0) c &= 0x1f, extra = 1;
+    else if ((c & 0xf0) == 0xe0) c &= 0x0f, extra = 2;
+    else if ((c & 0xf8) == 0xf0) c &= 0x07, extra = 3;
+    else return 0;
+
+    for (; extra > 0; --extra) {
+        if (p == end || (*p & 0xc0) != 0x80)
+            return 0;
+        c = (c << 6) | (*p++ & 0x3f);
+    }
+    return c;
+}
+
+/**
+ * Returns true if Shift should be held while typing [uChar].
+ * Most servers ignore the case of KeySym, and rely on Shift state instead.
+ * Assumes US layout for symbols.
+ */
+static bool needsShift(uint32_t uChar) {
+    if (uChar < 0x80)
+        return (uChar >= 'A' && uChar <= 'Z') || strchr("~!@#$%^&*()_+{}|:\"<>?", (int) uChar);
+
+    // Latin-1 uppercase letters
+    return uChar >= 0xc0 && uChar <= 0xde && uChar != 0xd7;
+}
+
+/**
+ * Returns KeySym to type [uChar], or 0 if it should be skipped.
+ */
+static uint32_t keySymForTyping(uint32_t uChar) {
+    switch (uChar) {
+        case '\n':
+        case '\r': return XK_Return;
+        case '\t': return XK_Tab;
+    }
+
+    if (uChar < 0x20 || uChar == 0x7f)
+        return 0;
+
+    return getKeySymForUnicodeChar(uChar);
+}
+
+static void addNanos(timespec *ts, long nanos) {
+    ts->tv_nsec += nanos;
+    while (ts->tv_nsec >= 1000000000L) {
+        ts->tv_nsec -= 1000000000L;
+        ts->tv_sec += 1;
+    }
+}
+
+/**
+ * Types given UTF-8 text.
+ * [rateLimit] is max number of characters per second. 0 means no limit.
+ * Returns false if connection fails.
+ */
+static bool typeText(rfbClient *client, const uint8_t *text, size_t len, int rateLimit) {
+    KeyEventBatch batch;
+    batch.count = 0;
+
+    // With rate limit, a batch is sent every tick
+    int charsPerBatch = rateLimit > 0 ? rateLimit / (1000000000L / TypeTextTickNs) : 0;
+    if (rateLimit > 0 && charsPerBatch < 1)
+        charsPerBatch = 1;
+
+    long batchIntervalNs = rateLimit > 0 ? (1000000000L / rateLimit) * charsPerBatch : 0;
+    timespec deadline{};
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+    const uint8_t *p = text;
+    const uint8_t *end = text + len;
+    bool shiftDown = false;
+    int charsInBatch = 0;
+
+    while (p < end) {
+        uint32_t uChar = nextCodePoint(p, end);
+
+        // Treat CR-LF as single Return
+        if (uChar == '\r' && p < end && *p == '\n')
+            continue;
+
+        uint32_t keySym = keySymForTyping(uChar);
+        if (keySym == 0)
+            continue;
+
+        bool shift = needsShift(uChar);
+        if (shift != shiftDown) {
+            appendKeyEvent(&batch, XK_Shift_L, shift);
+            shiftDown = shift;
+        }
+        appendKeyEvent(&batch, keySym, true);
+        appendKeyEvent(&batch, keySym, false);
+        ++charsInBatch;
+
+        bool batchFull = batch.count + 3 > TypeTextBatchSize;
+        bool tick = charsPerBatch > 0 && charsInBatch >= charsPerBatch;
+
+        if (batchFull || tick) {
+            if (!flushKeyEvents(client, &batch))
+                return false;
+        }
+
+        if (tick) {
+            charsInBatch = 0;
+            addNanos(&deadline, batchIntervalNs);
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr);
+        }
+    }
+
+    if (shiftDown)
+        appendKeyEvent(&batch, XK_Shift_L, false);
+
+    return flushKeyEvents(client, &batch);
+}
+
+#endif //AVNC_TEXTTYPER_H
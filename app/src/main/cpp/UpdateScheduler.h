@@ -0,0 +1,487 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_UPDATESCHEDULER_H
+#define AVNC_UPDATESCHEDULER_H
+
+#include <rfb/rfbclient.h>
+#include "Utility.h"
+
+/**
+ * Schedules framebuffer update requests.
+ *
+ * LibVNCClient normally sends next update request as soon as an update is
+ * received. But there is no point in receiving & decoding updates faster than
+ * they can be displayed. So automatic requests are disabled, and receiver thread
+ * sends the requests using this scheduler.
+ *
+ * Renderer reports the frame generations it has consumed. Next request is delayed
+ * until renderer is at most [maxLead] generations behind the receiver (see
+ * [setRenderLead]). If renderer
+ * doesn't catch up within [RenderWaitTimeoutUs] (e.g. nothing is being rendered),
+ * request is sent anyway.
+ *
+ * If display refresh timestamps are available (see [onVsync]), requests are
+ * further delayed so that, based on measured server round-trip time & decode
+ * cost, the update finishes shortly before a vsync. Otherwise, new pixels
+ * usually land just after a vsync, and wait almost a full frame before being
+ * displayed.
+ *
+ * An optional frame rate limit (e.g. while on battery) caps how often requests
+ * are sent. The limit is lifted for a short while after local input, so that
+ * interaction stays responsive.
+ *
+ * Explicit requests from the app (e.g. full refresh) bypass the scheduling, but
+ * go through [sendUpdateRequestNow], so the scheduler knows a request is pending.
+ */
+
+static const uint32_t DefaultRenderLead = 1;
+static const uint64_t RenderWaitTimeoutUs = 100 * 1000;
+static const unsigned int RenderPollIntervalUs = 4 * 1000;
+
+// Time reserved for texture upload before vsync
+static const uint64_t VsyncMarginUs = 2 * 1000;
+
+// Vsync alignment is disabled if we haven't heard from display for this long
+static const uint64_t VsyncStaleUs = 500 * 1000;
+
+// Vsync period is only updated from samples in this range
+static const uint64_t MinVsyncPeriodUs = 4 * 1000;
+static const uint64_t MaxVsyncPeriodUs = 50 * 1000;
+
+// Frame rate limit is not applied for this long after local input
+static const uint64_t InputBoostUs = 2 * 1000 * 1000;
+
+// Upper bounds of update-to-present latency histogram buckets
+static const uint64_t LatencyBucketsMs[] = {4, 8, 16, 33, 50, 100, 200, UINT64_MAX};
+static const int LatencyBucketCount = sizeof(LatencyBucketsMs) / sizeof(LatencyBucketsMs[0]);
+
+struct UpdateScheduler {
+    // Whether a request is waiting for an update from server.
+    // Explicit requests set it from other threads, so use atomic operations.
+    bool requestPending;
+
+    // Generation of most recently received frame, and of the frame
+    // uploaded by renderer. Accessed from multiple threads.
+    uint32_t generation;
+    uint32_t consumedGeneration;
+
+    // Max number of received frames renderer can be behind, written by main thread
+    uint32_t maxLead;
+
+    // When receiver started waiting for renderer, 0 if not waiting
+    uint64_t waitStartUs;
+
+    // Timing of current update request (use atomic operations for requestSentUs),
+    // and moving averages of server round-trip time and decode cost (receiver thread only).
+    uint64_t requestSentUs;
+    uint64_t messageStartUs;
+    uint64_t alignStartUs;
+    uint64_t rttUs;
+    uint64_t decodeUs;
+    bool hasTimingSample;
+
+    // Min interval between requests (0 for no limit), written by main thread
+    uint32_t minIntervalUs;
+
+    // Time of last local input, written by sender thread
+    uint64_t lastInputUs;
+
+    // When receiver started waiting because of frame rate limit, 0 if not waiting
+    uint64_t throttleStartUs;
+
+    // Moving average of receiver CPU time spent per update
+    uint64_t updateCpuUs;
+    uint64_t messageStartCpuUs;
+
+    // Display refresh, written by main thread
+    uint64_t lastVsyncUs;
+    uint64_t vsyncPeriodUs;
+
+    // Completion time of latest update (written by receiver), and of the
+    // update uploaded by renderer which is waiting to be presented.
+    uint64_t updateDoneUs;
+    uint64_t uploadedDoneUs;
+    uint64_t uploadedAtUs;
+
+    // Stats
+    uint64_t requestCount;  // Use atomic operations
+    uint64_t explicitCount; // Use atomic operations
+    uint64_t delayedCount;
+    uint64_t totalDelayUs;
+    uint64_t skippedFrames;
+    uint64_t alignedCount;
+    uint64_t totalAlignDelayUs;
+    uint64_t latencyHistogram[LatencyBucketCount];
+    uint64_t totalLatencyUs;
+    uint64_t throttledCount;
+    uint64_t totalThrottledUs;
+    uint64_t savedUpdates;
+    uint64_t savedCpuUs;
+};
+
+static void initUpdateScheduler(UpdateScheduler *scheduler) {
+    scheduler->requestPending = false;
+    scheduler->generation = 0;
+    scheduler->consumedGeneration = 0;
+    scheduler->maxLead = DefaultRenderLead;
+    scheduler->waitStartUs = 0;
+    scheduler->requestCount = 0;
+    scheduler->explicitCount = 0;
+    scheduler->delayedCount = 0;
+    scheduler->totalDelayUs = 0;
+    scheduler->skippedFrames = 0;
+    scheduler->requestSentUs = 0;
+    scheduler->messageStartUs = 0;
+    scheduler->alignStartUs = 0;
+    scheduler->rttUs = 0;
+    scheduler->decodeUs = 0;
+    scheduler->hasTimingSample = false;
+    scheduler->lastVsyncUs = 0;
+    scheduler->vsyncPeriodUs = 0;
+    scheduler->updateDoneUs = 0;
+    scheduler->uploadedDoneUs = 0;
+    scheduler->uploadedAtUs = 0;
+    scheduler->alignedCount = 0;
+    scheduler->totalAlignDelayUs = 0;
+    scheduler->totalLatencyUs = 0;
+    scheduler->minIntervalUs = 0;
+    scheduler->lastInputUs = 0;
+    scheduler->throttleStartUs = 0;
+    scheduler->updateCpuUs = 0;
+    scheduler->messageStartCpuUs = 0;
+    scheduler->throttledCount = 0;
+    scheduler->totalThrottledUs = 0;
+    scheduler->savedUpdates = 0;
+    scheduler->savedCpuUs = 0;
+    for (auto &count: scheduler->latencyHistogram)
+        count = 0;
+}
+
+/**
+ * Returns the smallest bucket bound which covers at least [percent] of samples.
+ */
+static uint64_t getLatencyPercentileMs(UpdateScheduler *scheduler, uint64_t total, uint64_t percent) {
+    uint64_t seen = 0;
+    for (int i = 0; i < LatencyBucketCount - 1; ++i) {
+        seen += scheduler->latencyHistogram[i];
+        if (seen * 100 >= total * percent)
+            return LatencyBucketsMs[i];
+    }
+    return LatencyBucketsMs[LatencyBucketCount - 2];
+}
+
+static void logLatencyStats(UpdateScheduler *scheduler) {
+    uint64_t total = 0;
+    for (auto count: scheduler->latencyHistogram)
+        total += count;
+
+    if (total == 0)
+        return;
+
+    auto &h = scheduler->latencyHistogram;
+    log_info("Update-to-present latency: %llu frames, avg %llums, p50 <=%llums, p90 <=%llums, p99 <=%llums",
+             (unsigned long long) total, (unsigned long long) (scheduler->totalLatencyUs / total / 1000),
+             (unsigned long long) getLatencyPercentileMs(scheduler, total, 50),
+             (unsigned long long) getLatencyPercentileMs(scheduler, total, 90),
+             (unsigned long long) getLatencyPercentileMs(scheduler, total, 99));
+    log_info("Latency histogram (ms): <4:%llu <8:%llu <16:%llu <33:%llu <50:%llu <100:%llu <200:%llu >=200:%llu",
+             (unsigned long long) h[0], (unsigned long long) h[1], (unsigned long long) h[2],
+             (unsigned long long) h[3], (unsigned long long) h[4], (unsigned long long) h[5],
+             (unsigned long long) h[6], (unsigned long long) h[7]);
+}
+
+static void logUpdateSchedulerStats(UpdateScheduler *scheduler) {
+    if (scheduler->requestCount == 0)
+        return;
+
+    auto avgDelayUs = scheduler->delayedCount ? scheduler->totalDelayUs / scheduler->delayedCount : 0;
+    log_info("Update requests: %llu sent (%llu explicit), %llu delayed for renderer (avg %llums), %llu frames never displayed",
+             (unsigned long long) scheduler->requestCount, (unsigned long long) scheduler->explicitCount,
+             (unsigned long long) scheduler->delayedCount, (unsigned long long) avgDelayUs / 1000,
+             (unsigned long long) scheduler->skippedFrames);
+
+    if (scheduler->alignedCount)
+        log_info("Vsync alignment: %llu requests delayed (avg %llums), RTT %llums, decode %llums",
+                 (unsigned long long) scheduler->alignedCount,
+                 (unsigned long long) (scheduler->totalAlignDelayUs / scheduler->alignedCount / 1000),
+                 (unsigned long long) scheduler->rttUs / 1000, (unsigned long long) scheduler->decodeUs / 1000);
+
+    if (scheduler->throttledCount)
+        log_info("Frame rate limit: %llu requests delayed for %llums total, ~%llu updates skipped, ~%llums CPU saved",
+                 (unsigned long long) scheduler->throttledCount,
+                 (unsigned long long) scheduler->totalThrottledUs / 1000,
+                 (unsigned long long) scheduler->savedUpdates, (unsigned long long) scheduler->savedCpuUs / 1000);
+
+    logLatencyStats(scheduler);
+}
+
+/**
+ * Called when an update request is sent. Can be called from any thread.
+ */
+static void onUpdateRequested(UpdateScheduler *scheduler) {
+    __atomic_store_n(&scheduler->requestSentUs, monotonicTimeUs(), __ATOMIC_RELAXED);
+    __atomic_store_n(&scheduler->requestPending, true, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&scheduler->requestCount, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * Called by receiver thread when it starts handling a server message.
+ */
+static void onServerMessageStart(UpdateScheduler *scheduler) {
+    scheduler->messageStartUs = monotonicTimeUs();
+    scheduler->messageStartCpuUs = threadCpuTimeUs();
+}
+
+static uint64_t movingAverage(uint64_t average, uint64_t sample) {
+    return average - average / 8 + sample / 8;
+}
+
+/**
+ * Called by receiver thread when a framebuffer update has been received.
+ */
+static void onUpdateReceived(UpdateScheduler *scheduler) {
+    auto now = monotonicTimeUs();
+    auto requestSentUs = __atomic_load_n(&scheduler->requestSentUs, __ATOMIC_RELAXED);
+    auto requestPending = __atomic_load_n(&scheduler->requestPending, __ATOMIC_ACQUIRE);
+
+    if (requestPending && requestSentUs && scheduler->messageStartUs >= requestSentUs) {
+        auto rtt = scheduler->messageStartUs - requestSentUs;
+        auto decode = now - scheduler->messageStartUs;
+        if (scheduler->hasTimingSample) {
+            scheduler->rttUs = movingAverage(scheduler->rttUs, rtt);
+            scheduler->decodeUs = movingAverage(scheduler->decodeUs, decode);
+            scheduler->updateCpuUs = movingAverage(scheduler->updateCpuUs, threadCpuTimeUs() - scheduler->messageStartCpuUs);
+        } else {
+            scheduler->rttUs = rtt;
+            scheduler->decodeUs = decode;
+            scheduler->updateCpuUs = threadCpuTimeUs() - scheduler->messageStartCpuUs;
+            scheduler->hasTimingSample = true;
+        }
+    }
+
+    __atomic_store_n(&scheduler->requestPending, false, __ATOMIC_RELEASE);
+    __atomic_store_n(&scheduler->updateDoneUs, now, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&scheduler->generation, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Called by renderer after framebuffer is uploaded.
+ */
+static void onFrameConsumed(UpdateScheduler *scheduler) {
+    auto generation = __atomic_load_n(&scheduler->generation, __ATOMIC_ACQUIRE);
+    auto previous = __atomic_exchange_n(&scheduler->consumedGeneration, generation, __ATOMIC_RELEASE);
+
+    // Frames received in between were never displayed.
+    // Stats are only approximate, so skippedFrames is not synchronized.
+    if (generation > previous + 1)
+        scheduler->skippedFrames += generation - previous - 1;
+
+    // Remember new frame until its presentation is reported via onVsync()
+    if (generation != previous) {
+        __atomic_store_n(&scheduler->uploadedAtUs, monotonicTimeUs(), __ATOMIC_RELAXED);
+        __atomic_store_n(&scheduler->uploadedDoneUs, __atomic_load_n(&scheduler->updateDoneUs, __ATOMIC_RELAXED),
+                         __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * Sets max number of update requests per second, 0 for no limit.
+ */
+static void setFrameRateLimit(UpdateScheduler *scheduler, int fps) {
+    uint32_t interval = fps > 0 ? 1000000 / fps : 0;
+    __atomic_store_n(&scheduler->minIntervalUs, interval, __ATOMIC_RELAXED);
+}
+
+/**
+ * Sets max number of received frames renderer can be behind, before next
+ * request is delayed. Higher values trade latency for throughput on
+ * high-latency connections. Minimum is 1.
+ */
+static void setRenderLead(UpdateScheduler *scheduler, int frames) {
+    __atomic_store_n(&scheduler->maxLead, (uint32_t) (frames > 1 ? frames : 1), __ATOMIC_RELAXED);
+}
+
+/**
+ * Called by sender thread when user input is sent to server.
+ */
+static void onLocalInput(UpdateScheduler *scheduler) {
+    __atomic_store_n(&scheduler->lastInputUs, monotonicTimeUs(), __ATOMIC_RELAXED);
+}
+
+/**
+ * Returns how long the next request should be delayed to honor frame rate limit.
+ */
+static uint64_t getFrameRateLimitDelay(UpdateScheduler *scheduler, uint64_t now) {
+    uint64_t interval = __atomic_load_n(&scheduler->minIntervalUs, __ATOMIC_RELAXED);
+    auto lastInput = __atomic_load_n(&scheduler->lastInputUs, __ATOMIC_RELAXED);
+    auto requestSentUs = __atomic_load_n(&scheduler->requestSentUs, __ATOMIC_RELAXED);
+
+    if (interval == 0 || now - lastInput < InputBoostUs || now - requestSentUs >= interval)
+        return 0;
+
+    return requestSentUs + interval - now;
+}
+
+/**
+ * Estimates the updates (and receiver CPU time) we would have processed
+ * without the frame rate limit, during a throttled period.
+ */
+static void recordThrottledPeriod(UpdateScheduler *scheduler, uint64_t durationUs) {
+    auto period = __atomic_load_n(&scheduler->vsyncPeriodUs, __ATOMIC_RELAXED);
+    auto cycle = scheduler->rttUs + scheduler->decodeUs;
+    if (cycle < period) cycle = period;
+    if (cycle < MinVsyncPeriodUs) cycle = MinVsyncPeriodUs;
+
+    auto updates = durationUs / cycle;
+    scheduler->throttledCount++;
+    scheduler->totalThrottledUs += durationUs;
+    scheduler->savedUpdates += updates;
+    scheduler->savedCpuUs += updates * scheduler->updateCpuUs;
+}
+
+static void recordLatency(UpdateScheduler *scheduler, uint64_t latencyUs) {
+    int i = 0;
+    while (latencyUs >= LatencyBucketsMs[i] * 1000)
+        ++i;
+
+    scheduler->latencyHistogram[i]++;
+    scheduler->totalLatencyUs += latencyUs;
+}
+
+/**
+ * Called by main thread with display refresh timestamps (Choreographer frame time).
+ *
+ * First vsync after renderer uploads a frame is taken as its presentation time.
+ */
+static void onVsync(UpdateScheduler *scheduler, uint64_t vsyncUs) {
+    auto last = __atomic_load_n(&scheduler->lastVsyncUs, __ATOMIC_RELAXED);
+    if (vsyncUs <= last)
+        return;
+
+    auto delta = vsyncUs - last;
+    if (last && delta >= MinVsyncPeriodUs && delta <= MaxVsyncPeriodUs * 4) {
+        // Callbacks may skip frames, so delta can span multiple periods
+        auto period = __atomic_load_n(&scheduler->vsyncPeriodUs, __ATOMIC_RELAXED);
+        if (period == 0) {
+            if (delta <= MaxVsyncPeriodUs)
+                period = delta;
+        } else {
+            auto frames = (delta + period / 2) / period;
+            period = movingAverage(period, delta / (frames ? frames : 1));
+        }
+        __atomic_store_n(&scheduler->vsyncPeriodUs, period, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&scheduler->lastVsyncUs, vsyncUs, __ATOMIC_RELAXED);
+
+    auto doneUs = __atomic_load_n(&scheduler->uploadedDoneUs, __ATOMIC_ACQUIRE);
+    auto uploadedAtUs = __atomic_load_n(&scheduler->uploadedAtUs, __ATOMIC_RELAXED);
+    if (doneUs && vsyncUs >= uploadedAtUs && vsyncUs >= doneUs) {
+        if (__atomic_compare_exchange_n(&scheduler->uploadedDoneUs, &doneUs, 0, false,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            recordLatency(scheduler, vsyncUs - doneUs);
+    }
+}
+
+/**
+ * Returns how long the next request should be delayed so that resulting
+ * update finishes just before a vsync. Returns 0 if alignment is not possible.
+ */
+static uint64_t getVsyncAlignmentDelay(UpdateScheduler *scheduler, uint64_t now) {
+    auto period = __atomic_load_n(&scheduler->vsyncPeriodUs, __ATOMIC_RELAXED);
+    auto last = __atomic_load_n(&scheduler->lastVsyncUs, __ATOMIC_RELAXED);
+
+    if (period == 0 || !scheduler->hasTimingSample || last > now || now - last > VsyncStaleUs)
+        return 0;
+
+    auto readyAt = now + scheduler->rttUs + scheduler->decodeUs + VsyncMarginUs;
+    auto nextVsync = last + ((readyAt - last + period - 1) / period) * period;
+    return nextVsync - readyAt;
+}
+
+/**
+ * Sends next update request if it is time for it.
+ * Called by receiver thread before waiting for server messages.
+ *
+ * Returns the timeout to be used for waiting, which is shortened if receiver
+ * needs to re-check the renderer soon.
+ */
+static unsigned int scheduleUpdateRequest(rfbClient *client, UpdateScheduler *scheduler, bool paused,
+                                          unsigned int timeoutUs) {
+    if (__atomic_load_n(&scheduler->requestPending, __ATOMIC_ACQUIRE) || paused) {
+        scheduler->waitStartUs = 0;
+        scheduler->alignStartUs = 0;
+        scheduler->throttleStartUs = 0;
+        return timeoutUs;
+    }
+
+    auto generation = __atomic_load_n(&scheduler->generation, __ATOMIC_ACQUIRE);
+    auto consumed = __atomic_load_n(&scheduler->consumedGeneration, __ATOMIC_ACQUIRE);
+    auto now = monotonicTimeUs();
+
+    if (generation - consumed >= __atomic_load_n(&scheduler->maxLead, __ATOMIC_RELAXED)) {
+        if (scheduler->waitStartUs == 0)
+            scheduler->waitStartUs = now;
+
+        if (now - scheduler->waitStartUs < RenderWaitTimeoutUs)
+            return timeoutUs < RenderPollIntervalUs ? timeoutUs : RenderPollIntervalUs;
+    }
+
+    if (scheduler->waitStartUs) {
+        scheduler->delayedCount++;
+        scheduler->totalDelayUs += now - scheduler->waitStartUs;
+        scheduler->waitStartUs = 0;
+    }
+
+    auto limitDelayUs = getFrameRateLimitDelay(scheduler, now);
+    if (limitDelayUs) {
+        if (scheduler->throttleStartUs == 0)
+            scheduler->throttleStartUs = now;
+        return timeoutUs < limitDelayUs ? timeoutUs : (unsigned int) limitDelayUs;
+    }
+
+    if (scheduler->throttleStartUs) {
+        recordThrottledPeriod(scheduler, now - scheduler->throttleStartUs);
+        scheduler->throttleStartUs = 0;
+    }
+
+    // Very short delays are not worth an extra wakeup
+    auto alignDelayUs = getVsyncAlignmentDelay(scheduler, now);
+    if (alignDelayUs >= RenderPollIntervalUs / 4) {
+        if (scheduler->alignStartUs == 0)
+            scheduler->alignStartUs = now;
+        return timeoutUs < alignDelayUs ? timeoutUs : (unsigned int) alignDelayUs;
+    }
+
+    if (scheduler->alignStartUs) {
+        scheduler->alignedCount++;
+        scheduler->totalAlignDelayUs += now - scheduler->alignStartUs;
+        scheduler->alignStartUs = 0;
+    }
+
+    if (SendIncrementalFramebufferUpdateRequest(client))
+        onUpdateRequested(scheduler);
+
+    return timeoutUs;
+}
+
+/**
+ * Sends an explicit update request for given region right away, without waiting
+ * for the renderer or frame rate limit. Can be called from any thread.
+ */
+static rfbBool sendUpdateRequestNow(rfbClient *client, UpdateScheduler *scheduler, int x, int y, int w, int h,
+                                    bool incremental) {
+    if (!SendFramebufferUpdateRequest(client, x, y, w, h, incremental ? TRUE : FALSE))
+        return FALSE;
+
+    onUpdateRequested(scheduler);
+    __atomic_add_fetch(&scheduler->explicitCount, 1, __ATOMIC_RELAXED);
+    return TRUE;
+}
+
+#endif //AVNC_UPDATESCHEDULER_H
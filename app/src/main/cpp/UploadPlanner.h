@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_UPLOADPLANNER_H
+#define AVNC_UPLOADPLANNER_H
+
+#include <stdlib.h>
+#include <rfb/rfbclient.h>
+#include "Utility.h"
+
+/**
+ * Plans framebuffer uploads to the GL texture.
+ *
+ * Uploading a full 4K framebuffer can take longer than a display frame, so the
+ * framebuffer is divided in tiles, and only damaged tiles are uploaded. Each frame
+ * gets an upload budget. Damaged tiles are uploaded in priority order until budget
+ * expires, and rest are carried over to the next frame.
+ *
+ * Priority order:
+ *  1. Tiles visible in viewport
+ *  2. Tiles under the cursor
+ *  3. Oldest damage
+ *
+ * Tiles taken for a frame can be grouped into stages (see [planStages]), which
+ * are used when uploading through pixel buffer objects.
+ *
+ * This file only does the bookkeeping, actual GL calls are made by the caller.
+ * Damage is reported by receiver/decoder threads, while planning & uploading
+ * is done on renderer thread.
+ */
+
+static const int UploadTileSize = 128;
+static const uint64_t UploadBudgetUs = 6 * 1000;
+
+// Region around cursor position which is considered 'under the cursor'
+static const int CursorPriorityRadius = 32;
+
+struct UploadRect {
+    int x, y, w, h;
+};
+
+static bool isRectEmpty(const UploadRect &r) {
+    return r.w <= 0 || r.h <= 0;
+}
+
+static bool rectsIntersect(const UploadRect &a, const UploadRect &b) {
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+static bool rectContains(const UploadRect &outer, const UploadRect &inner) {
+    return inner.x >= outer.x && inner.y >= outer.y &&
+           inner.x + inner.w <= outer.x + outer.w && inner.y + inner.h <= outer.y + outer.h;
+}
+
+/**
+ * Returns the intersection of given rects, with zero size if they don't intersect.
+ */
+static UploadRect intersectRects(const UploadRect &a, const UploadRect &b) {
+    int left = a.x > b.x ? a.x : b.x;
+    int top = a.y > b.y ? a.y : b.y;
+    int right = a.x + a.w < b.x + b.w ? a.x + a.w : b.x + b.w;
+    int bottom = a.y + a.h < b.y + b.h ? a.y + a.h : b.y + b.h;
+    if (right <= left || bottom <= top)
+        return {left, top, 0, 0};
+    return {left, top, right - left, bottom - top};
+}
+
+/**
+ * Renderer state used to prioritize tiles.
+ */
+struct UploadHints {
+    UploadRect viewport; // Visible part of the framebuffer
+    int cursorX, cursorY;
+};
+
+/**
+ * A region of framebuffer which is copied, as a compact block, into staging
+ * buffer at [offset]. Tiles in the stage are uploaded from this block with
+ * row length set to region width, so they don't need to be repacked.
+ */
+struct UploadStage {
+    UploadRect region;
+    size_t offset;
+
+    // Whether tiles in this stage cover whole region, i.e. it can be uploaded in a single call
+    bool contiguous;
+
+    // Range of tiles (in the array passed to planStages) belonging to this stage
+    int firstTile, tileCount;
+};
+
+// Max gap between tiles which can be merged into same stage
+static const int MaxStageGap = UploadTileSize;
+
+struct PlannedTile {
+    uint64_t key;
+    int index;
+};
+
+struct UploadPlanner {
+    int fbWidth, fbHeight;
+    int cols, rows;
+
+    // Per tile: time of oldest pending damage, 0 if tile is clean
+    uint64_t *damage;
+    int dirtyCount;
+
+    // Whether texture needs to be (re)allocated before uploading tiles
+    bool needsAllocation;
+
+    // Tiles to be uploaded in current frame, in priority order
+    PlannedTile *plan;
+    int planLength;
+
+    // Used for repacking sub-rectangles of framebuffer (renderer thread only)
+    uint32_t *scratch;
+    size_t scratchSize;
+
+    // Last cursor rect drawn into texture (renderer thread only)
+    UploadRect cursorRect;
+
+    // Stats
+    uint64_t frameCount;
+    uint64_t carriedOverFrames;
+    uint64_t uploadedTiles;
+    int maxCarriedOverTiles;
+
+    MUTEX(mutex);
+};
+
+static void initUploadPlanner(UploadPlanner *planner) {
+    INIT_MUTEX(planner->mutex);
+    planner->fbWidth = planner->fbHeight = 0;
+    planner->cols = planner->rows = 0;
+    planner->damage = nullptr;
+    planner->dirtyCount = 0;
+    planner->needsAllocation = true;
+    planner->plan = nullptr;
+    planner->planLength = 0;
+    planner->scratch = nullptr;
+    planner->scratchSize = 0;
+    planner->cursorRect = {0, 0, 0, 0};
+    planner->frameCount = 0;
+    planner->carriedOverFrames = 0;
+    planner->uploadedTiles = 0;
+    planner->maxCarriedOverTiles = 0;
+}
+
+static void destroyUploadPlanner(UploadPlanner *planner) {
+    if (planner->frameCount)
+        log_info("Texture uploads: %llu frames, %llu tiles, %llu frames exceeded budget (max %d tiles carried over)",
+                 (unsigned long long) planner->frameCount, (unsigned long long) planner->uploadedTiles,
+                 (unsigned long long) planner->carriedOverFrames, planner->maxCarriedOverTiles);
+
+    free(planner->damage);
+    free(planner->plan);
+    free(planner->scratch);
+    TINI_MUTEX(planner->mutex);
+}
+
+static void markAllTilesDamagedLocked(UploadPlanner *planner) {
+    auto now = monotonicTimeUs();
+    auto count = planner->cols * planner->rows;
+    for (int i = 0; i < count; ++i)
+        planner->damage[i] = now;
+    planner->dirtyCount = count;
+}
+
+/**
+ * Called when framebuffer is resized.
+ * Whole texture is reallocated & uploaded.
+ */
+static bool resizeUploadPlanner(UploadPlanner *planner, int fbWidth, int fbHeight) {
+    auto cols = (fbWidth + UploadTileSize - 1) / UploadTileSize;
+    auto rows = (fbHeight + UploadTileSize - 1) / UploadTileSize;
+    auto count = (size_t) cols * rows;
+    bool success = true;
+
+    LOCK(planner->mutex);
+    {
+        free(planner->damage);
+        free(planner->plan);
+        planner->damage = (uint64_t *) malloc(count * sizeof(uint64_t));
+        planner->plan = (PlannedTile *) malloc(count * sizeof(PlannedTile));
+
+        if (!planner->damage || !planner->plan) {
+            free(planner->damage);
+            free(planner->plan);
+            planner->damage = nullptr;
+            planner->plan = nullptr;
+            cols = rows = fbWidth = fbHeight = 0;
+            success = false;
+        }
+
+        planner->fbWidth = fbWidth;
+        planner->fbHeight = fbHeight;
+        planner->cols = cols;
+        planner->rows = rows;
+        planner->planLength = 0;
+        planner->needsAllocation = true;
+        planner->cursorRect = {0, 0, 0, 0};
+        markAllTilesDamagedLocked(planner);
+    }
+    UNLOCK(planner->mutex);
+
+    return success;
+}
+
+/**
+ * Called when texture contents are lost (e.g. a new GL context is created).
+ */
+static void invalidateUploadedTexture(UploadPlanner *planner) {
+    LOCK(planner->mutex);
+    planner->needsAllocation = true;
+    planner->cursorRect = {0, 0, 0, 0};
+    markAllTilesDamagedLocked(planner);
+    UNLOCK(planner->mutex);
+}
+
+/**
+ * Marks tiles overlapping given framebuffer rect as damaged.
+ */
+static void markDamage(UploadPlanner *planner, int x, int y, int w, int h) {
+    LOCK(planner->mutex);
+
+    int right = x + w, bottom = y + h;
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (right > planner->fbWidth) right = planner->fbWidth;
+    if (bottom > planner->fbHeight) bottom = planner->fbHeight;
+
+    if (x < right && y < bottom) {
+        auto now = monotonicTimeUs();
+        for (int row = y / UploadTileSize; row <= (bottom - 1) / UploadTileSize; ++row) {
+            for (int col = x / UploadTileSize; col <= (right - 1) / UploadTileSize; ++col) {
+                auto &damage = planner->damage[row * planner->cols + col];
+                if (damage == 0) {
+                    damage = now;
+                    planner->dirtyCount++;
+                }
+            }
+        }
+    }
+
+    UNLOCK(planner->mutex);
+}
+
+static bool isTileInRect(UploadPlanner *planner, int col, int row, int left, int top, int right, int bottom) {
+    auto tileLeft = col * UploadTileSize;
+    auto tileTop = row * UploadTileSize;
+    return tileLeft < right && tileLeft + UploadTileSize > left && tileTop < bottom && tileTop + UploadTileSize > top;
+}
+
+static int comparePlannedTiles(const void *a, const void *b) {
+    auto ka = ((const PlannedTile *) a)->key;
+    auto kb = ((const PlannedTile *) b)->key;
+    return ka < kb ? -1 : (ka > kb ? 1 : 0);
+}
+
+/**
+ * Builds the list of damaged tiles, in priority order, into [UploadPlanner.plan].
+ * Returns the number of planned tiles.
+ */
+static int planUploads(UploadPlanner *planner, const UploadHints *hints) {
+    auto v = hints->viewport;
+    auto cl = hints->cursorX - CursorPriorityRadius, cr = hints->cursorX + CursorPriorityRadius;
+    auto ct = hints->cursorY - CursorPriorityRadius, cb = hints->cursorY + CursorPriorityRadius;
+
+    LOCK(planner->mutex);
+
+    int length = 0;
+    if (planner->dirtyCount > 0) {
+        for (int row = 0; row < planner->rows; ++row) {
+            for (int col = 0; col < planner->cols; ++col) {
+                auto index = row * planner->cols + col;
+                auto damage = planner->damage[index];
+                if (damage == 0)
+                    continue;
+
+                // Priority class goes in the top bits, so that damage time only
+                // orders tiles within same class.
+                uint64_t invisible = !isTileInRect(planner, col, row, v.x, v.y, v.x + v.w, v.y + v.h);
+                uint64_t awayFromCursor = !isTileInRect(planner, col, row, cl, ct, cr, cb);
+                auto key = (invisible << 63) | (awayFromCursor << 62) | (damage & ((1ULL << 62) - 1));
+
+                planner->plan[length++] = {key, index};
+            }
+        }
+    }
+    planner->planLength = length;
+
+    UNLOCK(planner->mutex);
+
+    qsort(planner->plan, length, sizeof(PlannedTile), comparePlannedTiles);
+    return length;
+}
+
+/**
+ * Marks planned tile at [position] as clean, and returns its rect in [rect].
+ * Returns false if tile is no longer damaged.
+ *
+ * Tile is marked clean *before* it is uploaded, so that any damage reported
+ * during the upload makes it dirty again.
+ */
+static bool takePlannedTile(UploadPlanner *planner, int position, UploadRect *rect) {
+    auto index = planner->plan[position].index;
+    bool damaged;
+
+    LOCK(planner->mutex);
+    damaged = index < planner->cols * planner->rows && planner->damage[index] != 0;
+    if (damaged) {
+        planner->damage[index] = 0;
+        planner->dirtyCount--;
+    }
+    UNLOCK(planner->mutex);
+
+    if (damaged) {
+        auto x = (index % planner->cols) * UploadTileSize;
+        auto y = (index / planner->cols) * UploadTileSize;
+        rect->x = x;
+        rect->y = y;
+        rect->w = x + UploadTileSize > planner->fbWidth ? planner->fbWidth - x : UploadTileSize;
+        rect->h = y + UploadTileSize > planner->fbHeight ? planner->fbHeight - y : UploadTileSize;
+    }
+    return damaged;
+}
+
+/**
+ * Records outcome of a frame. [remaining] is the number of planned tiles
+ * which could not be uploaded within budget.
+ */
+static void finishUploadFrame(UploadPlanner *planner, int uploaded, int remaining) {
+    planner->frameCount++;
+    planner->uploadedTiles += uploaded;
+    if (remaining > 0) {
+        planner->carriedOverFrames++;
+        if (remaining > planner->maxCarriedOverTiles)
+            planner->maxCarriedOverTiles = remaining;
+    }
+}
+
+static bool hasPendingUploads(UploadPlanner *planner) {
+    LOCK(planner->mutex);
+    bool pending = planner->dirtyCount > 0 || planner->needsAllocation;
+    UNLOCK(planner->mutex);
+    return pending;
+}
+
+/**
+ * Groups [tiles] into stages. Tiles in same row, which are adjacent or separated
+ * by a small gap, are merged, so that they can be copied with one memcpy per row.
+ * [tiles] are reordered (by row, then column), and [stages] must have room for
+ * [count] entries.
+ *
+ * Returns the number of stages. Total size of staged data (in bytes) is
+ * returned in [stagedBytes].
+ */
+static int planStages(UploadRect *tiles, int count, UploadStage *stages, size_t *stagedBytes) {
+    // Insertion sort, count is small
+    for (int i = 1; i < count; ++i) {
+        auto tile = tiles[i];
+        int j = i - 1;
+        while (j >= 0 && (tiles[j].y > tile.y || (tiles[j].y == tile.y && tiles[j].x > tile.x))) {
+            tiles[j + 1] = tiles[j];
+            --j;
+        }
+        tiles[j + 1] = tile;
+    }
+
+    int stageCount = 0;
+    size_t offset = 0;
+
+    for (int i = 0; i < count; ++i) {
+        auto &tile = tiles[i];
+
+        if (stageCount > 0) {
+            auto &stage = stages[stageCount - 1];
+            auto &region = stage.region;
+            auto gap = tile.x - (region.x + region.w);
+
+            if (tile.y == region.y && tile.h == region.h && gap >= 0 && gap <= MaxStageGap) {
+                region.w = tile.x + tile.w - region.x;
+                stage.contiguous = stage.contiguous && gap == 0;
+                stage.tileCount++;
+                continue;
+            }
+
+            offset += (size_t) region.w * region.h * sizeof(uint32_t);
+        }
+
+        stages[stageCount++] = {tile, offset, true, i, 1};
+    }
+
+    if (stageCount > 0) {
+        auto &region = stages[stageCount - 1].region;
+        offset += (size_t) region.w * region.h * sizeof(uint32_t);
+    }
+
+    *stagedBytes = offset;
+    return stageCount;
+}
+
+/**
+ * Returns a buffer of at least [pixels] size, for repacking sub-rectangles.
+ */
+static uint32_t *getUploadScratch(UploadPlanner *planner, size_t pixels) {
+    if (planner->scratchSize < pixels) {
+        free(planner->scratch);
+        planner->scratch = (uint32_t *) malloc(pixels * sizeof(uint32_t));
+        planner->scratchSize = planner->scratch ? pixels : 0;
+    }
+    return planner->scratch;
+}
+
+#endif //AVNC_UPLOADPLANNER_H
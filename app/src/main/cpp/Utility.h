@@ -12,6 +12,7 @@
 #include <stdarg.h>
 #include <netdb.h>
 #include <errno.h>
+#include <time.h>
 #include <android/log.h>
 
 
@@ -30,6 +31,48 @@ static char *getNativeStrCopy(JNIEnv *env, jstring jStr) {
     return str;
 }
 
+/**
+ * Computes a 64-bit hash of given bytes.
+ * Input is consumed 8 bytes at a time, so it stays cheap for large buffers.
+ * This is NOT a cryptographic hash.
+ */
+static uint64_t hashBytes(const void *data, size_t len, uint64_t seed) {
+    const uint64_t prime = 0x9E3779B97F4A7C15ULL;
+    auto bytes = (const uint8_t *) data;
+    uint64_t h = (seed ^ len) * prime;
+    uint64_t w;
+
+    for (; len >= 8; len -= 8, bytes += 8) {
+        memcpy(&w, bytes, 8);
+        h = (h ^ w) * prime;
+        h ^= h >> 29;
+    }
+
+    w = 0;
+    memcpy(&w, bytes, len);
+    h = (h ^ w) * prime;
+    h ^= h >> 32;
+    return h;
+}
+
+/**
+ * Returns current time of monotonic clock, in microseconds.
+ */
+static uint64_t monotonicTimeUs() {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * Returns CPU time consumed by calling thread in microseconds.
+ */
+static uint64_t threadCpuTimeUs() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
 /******************************************************************************
  * Logging
  *****************************************************************************/
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_ZLIBSTREAMS_H
+#define AVNC_ZLIBSTREAMS_H
+
+#include <zlib.h>
+#include <rfb/rfbclient.h>
+#include "Utility.h"
+
+/**
+ * Reclaiming idle zlib streams
+ *
+ * LibVNCClient keeps up to five inflate streams per client: one shared by Zlib
+ * & ZRLE encodings, and four for Tight. Each takes ~40 KB (mostly the 32 KB
+ * window), and stays allocated for the whole connection, even if server never
+ * uses that stream again.
+ *
+ * These streams can't simply be freed, because server keeps compressing with
+ * its side of the stream, and later data refers back to the window. Instead,
+ * idle streams are 'parked': the window is extracted, compressed, and stream is
+ * released. Before next message is handled, parked streams are rebuilt as raw
+ * inflate streams (zlib header was consumed long ago) with the saved window as
+ * dictionary. Decoding then continues exactly as if stream was never released.
+ *
+ * This is only safe when stream is stopped at a block boundary with no leftover
+ * bits, which is the case after each rectangle, as servers flush with
+ * Z_SYNC_FLUSH. This is checked using data_type reported by inflate(). Streams
+ * not satisfying it are left alone.
+ *
+ * Everything here is done by receiver thread, outside of message handling.
+ */
+
+// Tight streams 0-3, followed by the stream shared by Zlib & ZRLE
+static const int ZlibStreamCount = 5;
+
+// Streams unused for this long are parked, once receiver is idle
+static const uint64_t ZlibStreamIdleUs = 60 * 1000 * 1000;
+
+// Approximate memory held by an active stream: state + 32 KB window
+static const size_t InflateStreamEstimate = 7 * 1024 + 32 * 1024;
+
+struct ParkedZlibStream {
+    uLong lastTotalIn; // total_in when usage was last checked
+    uint64_t lastUseUs;
+
+    // Compressed window, nullptr if stream is not parked
+    uint8_t *window;
+    uLongf windowSize;
+    uInt dictLength;
+};
+
+struct ZlibStreams {
+    ParkedZlibStream slots[ZlibStreamCount];
+
+    // Total size of parked windows. Read by other threads for accounting.
+    size_t parkedBytes;
+
+    // Stats
+    uint64_t parkCount;
+    uint64_t reclaimedBytes;
+};
+
+static void initZlibStreams(ZlibStreams *streams) {
+    for (auto &slot: streams->slots)
+        slot = {0, 0, nullptr, 0, 0};
+    streams->parkedBytes = 0;
+    streams->parkCount = 0;
+    streams->reclaimedBytes = 0;
+}
+
+static void destroyZlibStreams(ZlibStreams *streams) {
+    if (streams->parkCount)
+        log_info("Zlib streams: parked %llu times, ~%llu bytes reclaimed",
+                 (unsigned long long) streams->parkCount, (unsigned long long) streams->reclaimedBytes);
+
+    for (auto &slot: streams->slots)
+        free(slot.window);
+}
+
+/**
+ * Returns LibVNCClient's stream for given slot, and its 'active' flag.
+ */
+static z_stream *getZlibStream(rfbClient *client, int slot, rfbBool **active) {
+    if (slot < 4) {
+        *active = &client->zlibStreamActive[slot];
+        return &client->zlibStream[slot];
+    }
+    *active = &client->decompStreamInited;
+    return &client->decompStream;
+}
+
+/**
+ * Records which streams were used by last message.
+ */
+static void trackZlibStreamUse(rfbClient *client, ZlibStreams *streams) {
+    uint64_t now = 0;
+    for (int i = 0; i < ZlibStreamCount; ++i) {
+        rfbBool *active;
+        auto strm = getZlibStream(client, i, &active);
+        auto &slot = streams->slots[i];
+
+        if (*active && strm->total_in != slot.lastTotalIn) {
+            if (!now) now = monotonicTimeUs();
+            slot.lastTotalIn = strm->total_in;
+            slot.lastUseUs = now;
+        }
+    }
+}
+
+static bool parkZlibStream(rfbClient *client, ZlibStreams *streams, int index) {
+    rfbBool *active;
+    auto strm = getZlibStream(client, index, &active);
+    auto &slot = streams->slots[index];
+
+    // Must be waiting for next block header, with no bits left over, and
+    // not inside the final block. Header must have been consumed too.
+    if (!*active || slot.window || strm->total_in == 0 || strm->avail_in != 0 ||
+        (strm->data_type & (128 | 64 | 63)) != 128)
+        return false;
+
+    uInt dictLength = 0;
+    if (inflateGetDictionary(strm, nullptr, &dictLength) != Z_OK)
+        return false;
+
+    auto dict = (uint8_t *) malloc(dictLength ? dictLength : 1);
+    uLongf windowSize = compressBound(dictLength);
+    auto window = (uint8_t *) malloc(windowSize);
+
+    bool success = dict && window && inflateGetDictionary(strm, dict, &dictLength) == Z_OK &&
+                   compress2(window, &windowSize, dict, dictLength, Z_BEST_SPEED) == Z_OK;
+    free(dict);
+    if (!success) {
+        free(window);
+        return false;
+    }
+
+    auto trimmed = (uint8_t *) realloc(window, windowSize);
+    if (trimmed) window = trimmed;
+
+    inflateEnd(strm);
+    *active = FALSE;
+
+    slot.window = window;
+    slot.windowSize = windowSize;
+    slot.dictLength = dictLength;
+    __atomic_store_n(&streams->parkedBytes, streams->parkedBytes + windowSize, __ATOMIC_RELAXED);
+    streams->parkCount++;
+    if (windowSize < InflateStreamEstimate)
+        streams->reclaimedBytes += InflateStreamEstimate - windowSize;
+    return true;
+}
+
+/**
+ * Parks streams which haven't been used for [idleUs].
+ * Returns number of streams parked.
+ */
+static int parkIdleZlibStreams(rfbClient *client, ZlibStreams *streams, uint64_t idleUs) {
+    auto now = monotonicTimeUs();
+    int parked = 0;
+    for (int i = 0; i < ZlibStreamCount; ++i)
+        if (now - streams->slots[i].lastUseUs >= idleUs && parkZlibStream(client, streams, i))
+            parked++;
+    return parked;
+}
+
+static bool unparkZlibStream(rfbClient *client, ZlibStreams *streams, int index) {
+    rfbBool *active;
+    auto strm = getZlibStream(client, index, &active);
+    auto &slot = streams->slots[index];
+
+    uLongf dictLength = slot.dictLength;
+    auto dict = (uint8_t *) malloc(dictLength ? dictLength : 1);
+    if (!dict)
+        return false;
+
+    memset(strm, 0, sizeof(z_stream));
+    bool success = uncompress(dict, &dictLength, slot.window, slot.windowSize) == Z_OK &&
+                   dictLength == slot.dictLength &&
+                   inflateInit2(strm, -MAX_WBITS) == Z_OK;
+
+    if (success && inflateSetDictionary(strm, dict, (uInt) dictLength) != Z_OK) {
+        inflateEnd(strm);
+        success = false;
+    }
+    free(dict);
+
+    if (!success)
+        return false;
+
+    *active = TRUE;
+    __atomic_store_n(&streams->parkedBytes, streams->parkedBytes - slot.windowSize, __ATOMIC_RELAXED);
+    free(slot.window);
+    slot.window = nullptr;
+    slot.lastTotalIn = 0;
+    slot.lastUseUs = monotonicTimeUs(); // So that it isn't parked again right away
+    return true;
+}
+
+/**
+ * Rebuilds all parked streams. Must be called before handling a server message.
+ * Returns false if any stream could not be rebuilt, in which case connection
+ * can't continue.
+ */
+static bool unparkZlibStreams(rfbClient *client, ZlibStreams *streams) {
+    if (__atomic_load_n(&streams->parkedBytes, __ATOMIC_RELAXED) == 0)
+        return true;
+
+    for (int i = 0; i < ZlibStreamCount; ++i) {
+        if (streams->slots[i].window && !unparkZlibStream(client, streams, i)) {
+            rfbClientErr("Could not restore zlib stream %d\n", i);
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif //AVNC_ZLIBSTREAMS_H
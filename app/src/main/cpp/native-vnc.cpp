@@ -7,11 +7,17 @@
  */
 
 #include <jni.h>
-#include <GLES2/gl2.h>
+#include <GLES3/gl3.h>
 #include <rfb/rfbclient.h>
 
 #include "ClientEx.h"
 #include "Utility.h"
+#include "H264Decoder.h"
+#include "TextTyper.h"
+#include "Hibernate.h"
+#include "PixelWriter.h"
+#include "MemoryUsage.h"
+#include "Kernels.h"
 
 
 /******************************************************************************
@@ -22,6 +28,8 @@ struct JniContext {
     JavaVM *vm;                     //JVM Instance
     jclass managedCls;              //Managed `VncClient` class
     jmethodID cbFramebufferUpdated; //Cached reference to managed callback
+    jmethodID cbGotXCutText;        //Cached reference to managed callback
+    jmethodID cbHandleCursorPos;    //Cached reference to managed callback
 
     JNIEnv *getEnv() const {
         JNIEnv *env = nullptr;
@@ -45,6 +53,8 @@ JNI_OnLoad(JavaVM *vm, void *unused) {
     if (context.getEnv() == nullptr)
         return JNI_ERR;
 
+    initPixelKernels();
+
     return JNI_VERSION_1_6;
 }
 
@@ -65,6 +75,8 @@ Java_com_gaurav_avnc_vnc_VncClient_initLibrary(JNIEnv *env, jclass clazz) {
 
     context.managedCls = (jclass) env->NewGlobalRef(clazz);
     context.cbFramebufferUpdated = env->GetMethodID(context.managedCls, "cbFinishedFrameBufferUpdate", "()V");
+    context.cbGotXCutText = env->GetMethodID(context.managedCls, "cbGotXCutText", "(Ljava/nio/ByteBuffer;Z)V");
+    context.cbHandleCursorPos = env->GetMethodID(context.managedCls, "cbHandleCursorPos", "(II)V");
     //TODO: Cache more method IDs so we don't have to repeatedly search them
 
     rfbClientLog = &log_info;
@@ -132,14 +144,31 @@ static void onBell(rfbClient *client) {
 }
 
 static void onGotXCutText(rfbClient *client, const char *text, int len, bool is_utf8) {
+    // Checked before copying the text into Java heap, so large clips don't
+    // keep the receiver thread busy with allocation, decoding & binder IPC.
+    auto maxSize = getClientExtension(client)->maxCutTextSize;
+    if (maxSize > 0 && len > maxSize) {
+        rfbClientLog("Ignoring server cut text of %d bytes (limit: %d)\n", len, maxSize);
+        return;
+    }
+
+    // Some servers repeatedly send the same text
+    auto ex = getClientExtension(client);
+    auto hash = hashBytes(text, len, is_utf8);
+    if (hash == __atomic_exchange_n(&ex->lastCutTextHash, hash, __ATOMIC_RELAXED))
+        return;
+
     auto obj = getManagedClient(client);
     auto env = context.getEnv();
-    auto cls = context.managedCls;
 
-    jmethodID mid = env->GetMethodID(cls, "cbGotXCutText", "([BZ)V");
-    jbyteArray bytes = env->NewByteArray(len);
-    env->SetByteArrayRegion(bytes, 0, len, reinterpret_cast<const jbyte *>(text));
-    env->CallVoidMethod(obj, mid, bytes, is_utf8);
+    // Text is passed via a direct buffer, so it is decoded straight from native
+    // memory, instead of first being copied into a Java array. The buffer is
+    // only valid during this call.
+    auto buffer = env->NewDirectByteBuffer((void *) text, len);
+    if (buffer) {
+        env->CallVoidMethod(obj, context.cbGotXCutText, buffer, is_utf8);
+        env->DeleteLocalRef(buffer);
+    }
 }
 
 static void onGotXCutTextLatin1(rfbClient *client, const char *text, int len) {
@@ -150,24 +179,47 @@ static void onGotXCutTextUTF8(rfbClient *client, const char *text, int len) {
     onGotXCutText(client, text, len, true);
 }
 
-static rfbBool onHandleCursorPos(rfbClient *client, int x, int y) {
+static void onServerClipboardAvailable(rfbClient *client) {
     auto obj = getManagedClient(client);
     auto env = context.getEnv();
     auto cls = context.managedCls;
 
-    jmethodID mid = env->GetMethodID(cls, "cbHandleCursorPos", "(II)V");
-    env->CallVoidMethod(obj, mid, x, y);
+    jmethodID mid = env->GetMethodID(cls, "cbServerClipboardAvailable", "()V");
+    env->CallVoidMethod(obj, mid);
+}
+
+static rfbBool onHandleCursorPos(rfbClient *client, int x, int y) {
+    auto shift = getClientExtension(client)->fbShift;
+    x >>= shift;
+    y >>= shift;
+
+    auto obj = getManagedClient(client);
+    auto env = context.getEnv();
+
+    env->CallVoidMethod(obj, context.cbHandleCursorPos, x, y);
 
     return TRUE;
 }
 
 static void onFinishedFrameBufferUpdate(rfbClient *client) {
+    auto ex = getClientExtension(client);
+    if (ex->h264)
+        waitForH264Decoder(ex->h264);
+
     auto obj = getManagedClient(client);
     auto env = context.getEnv();
 
     env->CallVoidMethod(obj, context.cbFramebufferUpdated);
 }
 
+/**
+ * Called by LibVNCClient when a FramebufferUpdate message is fully handled.
+ */
+static void onFrameBufferUpdateDone(rfbClient *client) {
+    onUpdateReceived(&getClientExtension(client)->scheduler);
+    onFinishedFrameBufferUpdate(client);
+}
+
 /**
  * We need to use our own allocator to know when frame size has changed.
  * and to acquire framebuffer lock during modification.
@@ -176,7 +228,13 @@ static rfbBool onMallocFrameBuffer(rfbClient *client) {
 
     const auto width = client->width;
     const auto height = client->height;
-    const auto requestedSize = (uint64_t) width * height * client->format.bitsPerPixel / 8;
+    auto ex = getClientExtension(client);
+
+    // Downsampling is done by our pixel writers, so it is only possible when they are in use
+    auto shift = client->GotBitmap == copyBitmapBGRX32 ? chooseFrameBufferShift(width, height, ex->fbBudget) : 0;
+    const auto fbWidth = scaledLength(width, shift);
+    const auto fbHeight = scaledLength(height, shift);
+    const auto requestedSize = (uint64_t) fbWidth * fbHeight * client->format.bitsPerPixel / 8;
 
     if (requestedSize >= SIZE_MAX) {
         rfbClientErr("CRITICAL: cannot allocate frameBuffer, requested size is too large\n");
@@ -184,7 +242,9 @@ static rfbBool onMallocFrameBuffer(rfbClient *client) {
     }
 
     auto allocSize = (size_t) requestedSize;
-    auto ex = getClientExtension(client);
+
+    if (shift)
+        log_info("Framebuffer %dx%d is stored at %dx%d to fit in memory budget", width, height, fbWidth, fbHeight);
 
     LOCK(ex->mutex);
     {
@@ -192,16 +252,27 @@ static rfbBool onMallocFrameBuffer(rfbClient *client) {
         if (client->frameBuffer)
             free(client->frameBuffer);
 
+        dropLazyJpegs(&ex->jpeg);
+        releaseFrameDetailLocked(&ex->detail);
+
         client->frameBuffer = static_cast<uint8_t *>(malloc(allocSize));
 
         if (client->frameBuffer) {
-            ex->fbRealWidth = width;
-            ex->fbRealHeight = height;
+            ex->fbRealWidth = fbWidth;
+            ex->fbRealHeight = fbHeight;
+            ex->fbShift = shift;
             memset(client->frameBuffer, 0, allocSize); //Clear any garbage
         } else {
             ex->fbRealWidth = 0;
             ex->fbRealHeight = 0;
         }
+
+        if (!resizeUploadPlanner(&ex->uploads, ex->fbRealWidth, ex->fbRealHeight)) {
+            free(client->frameBuffer);
+            client->frameBuffer = nullptr;
+            ex->fbRealWidth = 0;
+            ex->fbRealHeight = 0;
+        }
     }
     UNLOCK(ex->mutex);
 
@@ -210,29 +281,100 @@ static rfbBool onMallocFrameBuffer(rfbClient *client) {
         return FALSE;
     }
 
+    // Warm up buffers used while handling updates, so that steady-state
+    // update processing doesn't need to allocate.
+    reserveScratch(&ex->cursorShape, CursorPreallocSize * CursorPreallocSize);
+    if (shift) {
+        reserveScratch(&ex->cursorScaled, CursorPreallocSize * CursorPreallocSize);
+        reserveScratch(&ex->fbScratch, (size_t) width + 2);
+    }
+
+    onDesktopSizeChanged(client, &ex->resize, width, height);
+
     auto obj = getManagedClient(client);
     auto env = context.getEnv();
     auto cls = context.managedCls;
 
     auto mid = env->GetMethodID(cls, "cbFramebufferSizeChanged", "(II)V");
-    env->CallVoidMethod(obj, mid, width, height);
+    env->CallVoidMethod(obj, mid, fbWidth, fbHeight);
 
     return TRUE;
 }
 
-static void onGotCursorShape(rfbClient *client, int xHot, int yHot, int width, int height, int bytesPerPixel) {
+static void onGotFrameBufferUpdate(rfbClient *client, int x, int y, int w, int h) {
     auto ex = getClientExtension(client);
+    auto r = scaleRectDown({x, y, w, h}, ex->fbShift);
+    markDamage(&ex->uploads, r.x, r.y, r.w, r.h);
+}
+
+/**
+ * Replaces cursor shape with the one prepared in ex->cursorShape, downsampling
+ * it to match the framebuffer. Must be called from receiver thread.
+ */
+static void setCursorShape(ClientEx *ex, uint16_t width, uint16_t height, uint16_t xHot, uint16_t yHot) {
+    auto shape = &ex->cursorShape;
+    auto shift = ex->fbShift;
+    auto fullWidth = width, fullHeight = height, fullXHot = xHot, fullYHot = yHot;
+    if (shift) {
+        auto w = (uint16_t) scaledLength(width, shift);
+        auto h = (uint16_t) scaledLength(height, shift);
+        auto scaled = reserveScratch(&ex->cursorScaled, (size_t) w * h);
+        if (scaled && downsampleBlock(scaled, w, shape->data, width, 0, 0, width, height, shift, &ex->fbScratch)) {
+            shape = &ex->cursorScaled;
+            width = w;
+            height = h;
+            xHot >>= shift;
+            yHot >>= shift;
+        }
+    }
 
     LOCK(ex->mutex);
+    if (ex->cursor)
+        updateCursor(ex->cursor, shape, width, height, xHot, yHot);
 
-    //Steel buffers from rfbClient
-    updateCursor(ex->cursor, client->rcSource, client->rcMask, (uint16_t) width, (uint16_t) height,
-                 (uint16_t) xHot, (uint16_t) yHot);
-    client->rcSource = NULL;
-    client->rcMask = NULL;
+    // Full resolution shape is kept for drawing in full resolution region
+    if (shape != &ex->cursorShape)
+        updateFrameDetailCursor(&ex->detail, &ex->cursorShape, fullWidth, fullHeight, fullXHot, fullYHot);
+    UNLOCK(ex->mutex);
+}
 
+/**
+ * Applies full resolution region requested by renderer, and requests its
+ * missing parts from server. See FrameDetail.h.
+ * Must be called from receiver thread, outside of message handling.
+ */
+static void applyFrameDetailRequest(rfbClient *client) {
+    auto ex = getClientExtension(client);
+    UploadRect rect, missing[4];
+    if (!takeFrameDetailRequest(&ex->detail, &rect))
+        return;
+
+    LOCK(ex->mutex);
+    // Framebuffer might have changed since the request
+    if (!client->frameBuffer || ex->fbShift == 0 || !rectContains({0, 0, client->width, client->height}, rect))
+        rect = {0, 0, 0, 0};
+    auto count = setFrameDetailRegionLocked(&ex->detail, rect, (uint32_t *) client->frameBuffer, ex->fbRealWidth,
+                                            ex->fbShift, missing);
+
+    // Region was filled from framebuffer, so JPEG rects pending there are decoded now, at full resolution
+    if (count)
+        resolveLazyJpegs(&ex->jpeg, &ex->uploads, getWriteTarget(client), rect, false);
     UNLOCK(ex->mutex);
 
+    for (int i = 0; i < count; ++i)
+        sendUpdateRequestNow(client, &ex->scheduler, missing[i].x, missing[i].y, missing[i].w, missing[i].h, false);
+}
+
+static void onGotCursorShape(rfbClient *client, int xHot, int yHot, int width, int height, int bytesPerPixel) {
+    auto ex = getClientExtension(client);
+    auto count = (size_t) width * height;
+    auto pixels = reserveScratch(&ex->cursorShape, count);
+    if (!pixels)
+        return;
+
+    cursorPixelsFromMask(pixels, client->rcSource, client->rcMask, count);
+    setCursorShape(ex, (uint16_t) width, (uint16_t) height, (uint16_t) xHot, (uint16_t) yHot);
+
     //Fake framebuffer update to trigger rendering
     onFinishedFrameBufferUpdate(client);
 }
@@ -246,13 +388,160 @@ static void setCallbacks(rfbClient *client) {
     client->Bell = onBell;
     client->GotXCutText = onGotXCutTextLatin1;
     client->GotXCutTextUTF8 = onGotXCutTextUTF8;
+    getClientExtension(client)->clipboard.onServerTextAvailable = onServerClipboardAvailable;
     client->HandleCursorPos = onHandleCursorPos;
-    client->FinishedFrameBufferUpdate = onFinishedFrameBufferUpdate;
+    client->GotFrameBufferUpdate = onGotFrameBufferUpdate;
+    client->FinishedFrameBufferUpdate = onFrameBufferUpdateDone;
     client->MallocFrameBuffer = onMallocFrameBuffer;
     client->GotCursorShape = onGotCursorShape;
 }
 
 
+/******************************************************************************
+ * Protocol Extensions
+ *****************************************************************************/
+
+/**
+ * Handles 'Cursor With Alpha' pseudo-encoding.
+ * Rectangle position is the hotspot, and the shape is wrapped in another
+ * encoding. Only Raw is supported, which is what servers use in practice.
+ */
+static rfbBool handleCursorWithAlpha(rfbClient *client, rfbFramebufferUpdateRectHeader *rect) {
+    int32_t encoding;
+    if (!ReadFromRFBServer(client, (char *) &encoding, sizeof(encoding)))
+        return FALSE;
+
+    encoding = (int32_t) rfbClientSwap32IfLE(encoding);
+    if (encoding != rfbEncodingRaw) {
+        rfbClientErr("Unsupported encoding for alpha cursor: %d\n", encoding);
+        return FALSE;
+    }
+
+    auto width = rect->r.w;
+    auto height = rect->r.h;
+    if (width > CursorMaxSize || height > CursorMaxSize) {
+        rfbClientErr("Alpha cursor too large: %dx%d\n", width, height);
+        return FALSE;
+    }
+
+    auto count = (size_t) width * height;
+    if (count == 0)
+        return TRUE;
+
+    // Shape is read into the staging buffer, and converted in-place
+    auto ex = getClientExtension(client);
+    auto pixels = reserveScratch(&ex->cursorShape, count);
+    if (!pixels || !ReadFromRFBServer(client, (char *) pixels, count * 4))
+        return FALSE;
+
+    cursorPixelsFromRGBA(pixels, (const uint8_t *) pixels, count);
+    setCursorShape(ex, width, height, rect->r.x, rect->r.y);
+
+    //Fake framebuffer update to trigger rendering
+    onFinishedFrameBufferUpdate(client);
+    return TRUE;
+}
+
+/**
+ * Handles encodings not natively supported by LibVNCClient.
+ */
+static rfbBool onHandleEncoding(rfbClient *client, rfbFramebufferUpdateRectHeader *rect) {
+    auto ex = getClientExtension(client);
+    auto encoding = (int32_t) rect->encoding;
+
+    if (encoding == OpenH264Encoding) {
+        if (!ex->h264 && !newH264Decoder(client))
+            return FALSE;
+        return queueH264Rect(client, ex->h264, rect);
+    }
+
+    if (encoding == CursorWithAlphaEncoding)
+        return handleCursorWithAlpha(client, rect);
+
+    return FALSE;
+}
+
+/**
+ * Encodings of an extension are appended to the list sent by LibVNCClient,
+ * for every client. Our encodings depend on client config (H.264 must be on
+ * top, alpha cursor only with local cursor), so none are declared here.
+ * Instead, we send our own list (see sendEncodings()).
+ */
+static rfbClientProtocolExtension protocolExtension = {
+        nullptr,            // encodings
+        onHandleEncoding,   // handleEncoding
+        nullptr,            // handleMessage
+        nullptr,            // next
+        nullptr,            // securityTypes
+        nullptr,            // handleAuthentication
+};
+
+static void registerProtocolExtension() {
+    static bool registered = false;
+    if (!registered) {
+        rfbClientRegisterExtension(&protocolExtension);
+        registered = true;
+    }
+}
+
+/**
+ * Servers pick the first encoding from our list which they support.
+ * LibVNCClient doesn't allow us to put H.264 before its own encodings, or to
+ * add per-client pseudo-encodings, so we re-send the list after connection
+ * is initialized. Rest of the list mirrors what LibVNCClient sends by default.
+ */
+static rfbBool sendEncodings(rfbClient *client) {
+    const int MaxEncodings = 32;
+    uint32_t encodings[MaxEncodings];
+    int count = 0;
+
+    if (getClientExtension(client)->preferH264)
+        encodings[count++] = OpenH264Encoding;
+
+    // See nativeConfigure()
+    if (strcmp(client->appData.encodingsString, "raw") != 0) {
+        encodings[count++] = rfbEncodingTight;
+        encodings[count++] = rfbEncodingZRLE;
+        encodings[count++] = rfbEncodingCopyRect;
+        encodings[count++] = rfbEncodingHextile;
+        encodings[count++] = rfbEncodingZlib;
+    }
+    encodings[count++] = rfbEncodingRaw;
+
+    if (client->appData.compressLevel >= 0 && client->appData.compressLevel <= 9)
+        encodings[count++] = rfbEncodingCompressLevel0 + client->appData.compressLevel;
+    if (client->appData.qualityLevel >= 0 && client->appData.qualityLevel <= 9)
+        encodings[count++] = rfbEncodingQualityLevel0 + client->appData.qualityLevel;
+
+    if (client->appData.useRemoteCursor) {
+        encodings[count++] = CursorWithAlphaEncoding;
+        encodings[count++] = rfbEncodingXCursor;
+        encodings[count++] = rfbEncodingRichCursor;
+        encodings[count++] = rfbEncodingPointerPos;
+    }
+
+    encodings[count++] = rfbEncodingKeyboardLedState;
+    encodings[count++] = rfbEncodingLastRect;
+    encodings[count++] = rfbEncodingNewFBSize;
+    encodings[count++] = rfbEncodingExtDesktopSize;
+    encodings[count++] = rfbEncodingSupportedMessages;
+    encodings[count++] = rfbEncodingQemuExtendedKeyEvent;
+    encodings[count++] = rfbEncodingExtendedClipboard;
+
+    char buf[sz_rfbSetEncodingsMsg + MaxEncodings * 4];
+    auto msg = (rfbSetEncodingsMsg *) buf;
+    msg->type = rfbSetEncodings;
+    msg->pad = 0;
+    msg->nEncodings = rfbClientSwap16IfLE(count);
+
+    auto list = (uint32_t *) (buf + sz_rfbSetEncodingsMsg);
+    for (int i = 0; i < count; ++i)
+        list[i] = rfbClientSwap32IfLE(encodings[i]);
+
+    return WriteToRFBServer(client, buf, sz_rfbSetEncodingsMsg + count * 4);
+}
+
+
 /******************************************************************************
  * Native method Implementation
  *****************************************************************************/
@@ -268,6 +557,7 @@ Java_com_gaurav_avnc_vnc_VncClient_nativeClientCreate(JNIEnv *env, jobject thiz)
         return 0;
 
     setCallbacks(client);
+    registerProtocolExtension();
     client->canHandleNewFBSize = TRUE;
 
     //Attach reference to managed object
@@ -281,7 +571,7 @@ extern "C"
 JNIEXPORT void JNICALL
 Java_com_gaurav_avnc_vnc_VncClient_nativeConfigure(JNIEnv *env, jobject thiz, jlong client_ptr,
                                                    jint securityType, jboolean use_local_cursor, jint image_quality,
-                                                   jboolean use_raw_encoding) {
+                                                   jboolean use_raw_encoding, jboolean use_h264) {
     auto client = (rfbClient *) client_ptr;
 
     // 0 means all auth types
@@ -298,6 +588,8 @@ Java_com_gaurav_avnc_vnc_VncClient_nativeConfigure(JNIEnv *env, jobject thiz, jl
     client->appData.qualityLevel = image_quality;
     if (use_raw_encoding)
         client->appData.encodingsString = "raw";
+    else if (use_h264)
+        getClientExtension(client)->preferH264 = true;
 
     // Change pixel format to match with the default format used by most VNC
     // servers. Technically, we should not have to this as VNC servers have to
@@ -309,6 +601,8 @@ Java_com_gaurav_avnc_vnc_VncClient_nativeConfigure(JNIEnv *env, jobject thiz, jl
     client->format.redShift = 16;
     client->format.greenShift = 8;
     client->format.blueShift = 0;
+
+    installPixelWriters(client);
 }
 
 extern "C"
@@ -330,6 +624,15 @@ Java_com_gaurav_avnc_vnc_VncClient_nativeInit(JNIEnv *env, jobject thiz, jlong c
     client->serverPort = port < 100 ? port + 5900 : port;
 
     if (rfbInitClient(client, nullptr, nullptr)) {
+        auto ex = getClientExtension(client);
+        if ((ex->preferH264 || client->appData.useRemoteCursor) && !sendEncodings(client))
+            return JNI_FALSE;
+        startPeriod(client, &ex->background);
+
+        // Update requests are sent by our scheduler.
+        // First request has already been sent by rfbInitClient().
+        client->automaticUpdateRequests = FALSE;
+        onUpdateRequested(&ex->scheduler);
         return JNI_TRUE;
     }
 
@@ -348,15 +651,26 @@ JNIEXPORT void JNICALL
 Java_com_gaurav_avnc_vnc_VncClient_nativeCleanup(JNIEnv *env, jobject thiz,
                                                  jlong client_ptr) {
     auto client = (rfbClient *) client_ptr;
+    auto ex = getClientExtension(client);
 
+    // Decoder thread & its painters write into the framebuffer,
+    // so they must be stopped before it is freed.
+    auto h264 = ex->h264;
+    __atomic_store_n(&ex->h264, nullptr, __ATOMIC_RELEASE);
+    freeH264Decoder(h264);
+
+    LOCK(ex->mutex);
     if (client->frameBuffer) {
         free(client->frameBuffer);
         client->frameBuffer = nullptr;
     }
+    UNLOCK(ex->mutex);
 
     auto managedClient = getManagedClient(client);
     env->DeleteGlobalRef(managedClient);
 
+    freeHibernatedFrameBuffer(ex->hibernated);
+
     freeClientExtension(client);
     rfbClientCleanup(client);
 }
@@ -367,16 +681,35 @@ Java_com_gaurav_avnc_vnc_VncClient_nativeProcessServerMessage(JNIEnv *env, jobje
                                                               jlong client_ptr,
                                                               jint u_sec_timeout) {
     auto client = (rfbClient *) client_ptr;
+    auto ex = getClientExtension(client);
 
-    auto waitResult = WaitForMessage(client, static_cast<unsigned int>(u_sec_timeout));
+    trimMemoryIfRequested(client);
+    checkResizeTimeout(client, &ex->resize, client->width, client->height);
+    applyFrameDetailRequest(client);
 
-    if (waitResult == 0) // Timeout
-        return JNI_TRUE;
+    auto timeout = scheduleUpdateRequest(client, &ex->scheduler, isUpdatesPaused(&ex->background),
+                                         static_cast<unsigned int>(u_sec_timeout));
+    auto waitResult = WaitForMessage(client, timeout);
 
-    if (waitResult > 0 && HandleRFBServerMessage(client))
+    if (waitResult == 0) { // Timeout
+        hibernateIfIdle(client);
+        parkIdleZlibStreams(client, &ex->zlibStreams, ZlibStreamIdleUs);
         return JNI_TRUE;
+    }
 
-    return JNI_FALSE;
+    // Incoming message may modify the framebuffer, or continue a zlib stream
+    if (waitResult < 0 || !restoreFrameBuffer(client) || !unparkZlibStreams(client, &ex->zlibStreams))
+        return JNI_FALSE;
+
+    onServerMessageStart(&ex->scheduler);
+
+    // Cut text is handled by us, see Clipboard.h
+    bool isCutText;
+    auto handled = handleServerCutText(client, &ex->clipboard, ex->maxCutTextSize, &isCutText);
+    if (handled && !isCutText)
+        handled = HandleRFBServerMessage(client);
+    trackZlibStreamUse(client, &ex->zlibStreams);
+    return handled ? JNI_TRUE : JNI_FALSE;
 }
 
 extern "C"
@@ -386,24 +719,99 @@ Java_com_gaurav_avnc_vnc_VncClient_nativeGetLastErrorStr(JNIEnv *env, jobject th
     return env->NewStringUTF(str);
 }
 
+static rfbBool sendKey(rfbClient *client, uint32_t keySym, uint32_t xtCode, bool isDown) {
+    rfbBool down = isDown ? TRUE : FALSE;
+    onLocalInput(&getClientExtension(client)->scheduler);
+
+    if (xtCode > 0 && SendExtendedKeyEvent(client, keySym, xtCode, down))
+        return TRUE;
+    else
+        return SendKeyEvent(client, keySym, down);
+}
+
 extern "C"
 JNIEXPORT jboolean JNICALL
 Java_com_gaurav_avnc_vnc_VncClient_nativeSendKeyEvent(JNIEnv *env, jobject thiz, jlong client_ptr,
                                                       jint key_sym, jint xt_code, jboolean is_down) {
+    return sendKey((rfbClient *) client_ptr, key_sym, xt_code, is_down);
+}
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_gaurav_avnc_vnc_VncClient_nativeSendAndroidKeyEvent(JNIEnv *env, jobject thiz, jlong client_ptr,
+                                                             jint key_code, jint scan_code, jboolean is_down) {
+    auto keySym = getKeySymForAndroidKeyCode(key_code);
+    if (keySym == 0)
+        return JNI_FALSE;
+
+    auto xtCode = getXTKeyCodeForAndroidScanCode(scan_code);
+    return sendKey((rfbClient *) client_ptr, keySym, xtCode, is_down);
+}
+
+/******************************************************************************
+ * Key translation tables (see XKeySym.h)
+ *****************************************************************************/
+
+extern "C"
+JNIEXPORT jint JNICALL
+Java_com_gaurav_avnc_vnc_XKeySymAndroid_getKeySymForAndroidKeyCode(JNIEnv *env, jclass clazz, jint key_code) {
+    return (jint) getKeySymForAndroidKeyCode(key_code);
+}
+
+extern "C"
+JNIEXPORT jint JNICALL
+Java_com_gaurav_avnc_vnc_XTKeyCode_fromAndroidScancode(JNIEnv *env, jclass clazz, jint scancode) {
+    return (jint) getXTKeyCodeForAndroidScanCode(scancode);
+}
+
+extern "C"
+JNIEXPORT jint JNICALL
+Java_com_gaurav_avnc_vnc_XKeySymUnicode_getLegacyKeySymForUnicodeChar(JNIEnv *env, jclass clazz, jint u_char) {
+    return (jint) getLegacyKeySymForUnicodeChar((uint32_t) u_char);
+}
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_gaurav_avnc_vnc_VncClient_nativeTypeText(JNIEnv *env, jobject thiz, jlong client_ptr, jbyteArray utf8_bytes,
+                                                  jint rate_limit) {
     auto client = (rfbClient *) client_ptr;
-    rfbBool down = is_down ? TRUE : FALSE;
+    auto textLen = env->GetArrayLength(utf8_bytes);
+    auto textBuffer = env->GetByteArrayElements(utf8_bytes, nullptr);
 
-    if (xt_code > 0 && SendExtendedKeyEvent(client, key_sym, xt_code, down))
-        return JNI_TRUE;
-    else
-        return SendKeyEvent(client, key_sym, down);
+    auto result = typeText(client, reinterpret_cast<const uint8_t *>(textBuffer), textLen, rate_limit);
+
+    env->ReleaseByteArrayElements(utf8_bytes, textBuffer, JNI_ABORT);
+    return (jboolean) result;
 }
 
 extern "C"
 JNIEXPORT jboolean JNICALL
 Java_com_gaurav_avnc_vnc_VncClient_nativeSendPointerEvent(JNIEnv *env, jobject thiz, jlong client_ptr, jint x, jint y,
                                                           jint mask) {
-    return (jboolean) SendPointerEvent((rfbClient *) client_ptr, x, y, mask);
+    auto client = (rfbClient *) client_ptr;
+    auto ex = getClientExtension(client);
+    auto shift = __atomic_load_n(&ex->fbShift, __ATOMIC_RELAXED);
+    onLocalInput(&ex->scheduler);
+    return (jboolean) SendPointerEvent(client, scaleCoordinateUp(x, shift), scaleCoordinateUp(y, shift), mask);
+}
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_gaurav_avnc_vnc_VncClient_nativeQueueScroll(JNIEnv *env, jobject thiz, jlong client_ptr, jint x, jint y,
+                                                     jint button_mask, jint h_ticks, jint v_ticks) {
+    auto ex = getClientExtension((rfbClient *) client_ptr);
+    auto shift = __atomic_load_n(&ex->fbShift, __ATOMIC_RELAXED);
+    return queueScroll(&ex->scroll, scaleCoordinateUp(x, shift), scaleCoordinateUp(y, shift),
+                       button_mask, h_ticks, v_ticks);
+}
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_gaurav_avnc_vnc_VncClient_nativeFlushScroll(JNIEnv *env, jobject thiz, jlong client_ptr) {
+    auto client = (rfbClient *) client_ptr;
+    auto ex = getClientExtension(client);
+    onLocalInput(&ex->scheduler);
+    return (jboolean) flushScroll(client, &ex->scroll);
 }
 
 extern "C"
@@ -411,18 +819,49 @@ JNIEXPORT jboolean JNICALL
 Java_com_gaurav_avnc_vnc_VncClient_nativeSendCutText(JNIEnv *env, jobject thiz, jlong client_ptr, jbyteArray bytes,
                                                      jboolean is_utf8) {
     auto client = (rfbClient *) client_ptr;
-    auto textBuffer = env->GetByteArrayElements(bytes, nullptr);
     auto textLen = env->GetArrayLength(bytes);
+
+    auto maxSize = getClientExtension(client)->maxCutTextSize;
+    if (maxSize > 0 && textLen > maxSize) {
+        rfbClientLog("Not sending cut text of %d bytes (limit: %d)\n", textLen, maxSize);
+        return JNI_FALSE;
+    }
+
+    auto textBuffer = env->GetByteArrayElements(bytes, nullptr);
     auto textChars = reinterpret_cast<char *>(textBuffer);
 
-    rfbBool result = is_utf8
+    auto ex = getClientExtension(client);
+    auto hash = hashBytes(textChars, textLen, is_utf8);
+    rfbBool result = TRUE;
+
+    // No need to send the text server already has
+    if (hash != __atomic_load_n(&ex->lastCutTextHash, __ATOMIC_RELAXED)) {
+        // Only announce the text if server can request it later, otherwise send it now
+        if (!is_utf8 || !announceLocalClipboard(client, &ex->clipboard, textChars, textLen, &result))
+            result = is_utf8
                      ? SendClientCutTextUTF8(client, textChars, textLen)
                      : SendClientCutText(client, textChars, textLen);
+        if (result)
+            __atomic_store_n(&ex->lastCutTextHash, hash, __ATOMIC_RELAXED);
+    }
 
     env->ReleaseByteArrayElements(bytes, textBuffer, JNI_ABORT);
     return (jboolean) result;
 }
 
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_gaurav_avnc_vnc_VncClient_nativeSetMaxCutTextSize(JNIEnv *env, jobject thiz, jlong client_ptr, jint max_size) {
+    getClientExtension((rfbClient *) client_ptr)->maxCutTextSize = max_size > 0 ? max_size : 0;
+}
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_gaurav_avnc_vnc_VncClient_nativeRequestServerCutText(JNIEnv *env, jobject thiz, jlong client_ptr) {
+    auto client = (rfbClient *) client_ptr;
+    return (jboolean) requestServerClipboard(client, &getClientExtension(client)->clipboard);
+}
+
 extern "C"
 JNIEXPORT jboolean JNICALL
 Java_com_gaurav_avnc_vnc_VncClient_nativeIsUTF8CutTextSupported(JNIEnv *env, jobject thiz, jlong client_ptr) {
@@ -433,14 +872,34 @@ extern "C"
 JNIEXPORT jboolean JNICALL
 Java_com_gaurav_avnc_vnc_VncClient_nativeSetDesktopSize(JNIEnv *env, jobject thiz, jlong client_ptr, jint width,
                                                         jint height) {
-    return (jboolean) SendExtDesktopSize((rfbClient *) client_ptr, width, height);
+    auto client = (rfbClient *) client_ptr;
+    auto ex = getClientExtension(client);
+
+    // Compare against server size, framebuffer may be stored at reduced resolution
+    LOCK(ex->mutex);
+    auto currentWidth = client->width;
+    auto currentHeight = client->height;
+    UNLOCK(ex->mutex);
+
+    return (jboolean) requestDesktopSize(client, &ex->resize, width, height, currentWidth, currentHeight);
 }
 
 extern "C"
 JNIEXPORT jboolean JNICALL
 Java_com_gaurav_avnc_vnc_VncClient_nativeRefreshFrameBuffer(JNIEnv *env, jobject thiz, jlong clientPtr) {
     auto client = (rfbClient *) clientPtr;
-    return (jboolean) SendFramebufferUpdateRequest(client, 0, 0, client->width, client->height, TRUE);
+    auto scheduler = &getClientExtension(client)->scheduler;
+    return sendUpdateRequestNow(client, scheduler, 0, 0, client->width, client->height, true);
+}
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_gaurav_avnc_vnc_VncClient_nativeRequestFrameBufferUpdate(JNIEnv *env, jobject thiz, jlong client_ptr, jint x,
+                                                                  jint y, jint w, jint h) {
+    auto client = (rfbClient *) client_ptr;
+    auto ex = getClientExtension(client);
+    auto r = scaleRectUp({x, y, w, h}, ex->fbShift);
+    return sendUpdateRequestNow(client, &ex->scheduler, r.x, r.y, r.w, r.h, true);
 }
 
 extern "C"
@@ -448,8 +907,66 @@ JNIEXPORT void JNICALL
 Java_com_gaurav_avnc_vnc_VncClient_nativeSetAutomaticFramebufferUpdates(JNIEnv *env, jobject thiz, jlong client_ptr,
                                                                         jboolean enabled) {
     auto client = ((rfbClient *) client_ptr);
-    client->automaticUpdateRequests = enabled ? TRUE : FALSE;
-    if (enabled) SendIncrementalFramebufferUpdateRequest(client);
+    auto ex = getClientExtension(client);
+
+    if (enabled) {
+        restoreFrameBuffer(client);
+        resumeUpdates(client, &ex->background);
+    } else {
+        pauseUpdates(client, &ex->background);
+    }
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_gaurav_avnc_vnc_VncClient_nativeSetFrameRateLimit(JNIEnv *env, jobject thiz, jlong client_ptr, jint fps) {
+    auto client = (rfbClient *) client_ptr;
+    setFrameRateLimit(&getClientExtension(client)->scheduler, fps);
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_gaurav_avnc_vnc_VncClient_nativeSetRenderLead(JNIEnv *env, jobject thiz, jlong client_ptr, jint frames) {
+    auto client = (rfbClient *) client_ptr;
+    setRenderLead(&getClientExtension(client)->scheduler, frames);
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_gaurav_avnc_vnc_VncClient_nativeSetFrameBufferBudget(JNIEnv *env, jobject thiz, jlong client_ptr,
+                                                              jlong bytes) {
+    getClientExtension((rfbClient *) client_ptr)->fbBudget = bytes > 0 ? (size_t) bytes : 0;
+}
+
+extern "C"
+JNIEXPORT jlongArray JNICALL
+Java_com_gaurav_avnc_vnc_VncClient_nativeGetMemoryUsage(JNIEnv *env, jobject thiz, jlong client_ptr) {
+    size_t usage[MemCategoryCount];
+    getMemoryUsage((rfbClient *) client_ptr, usage);
+
+    jlong values[MemCategoryCount];
+    for (int i = 0; i < MemCategoryCount; ++i)
+        values[i] = (jlong) usage[i];
+
+    auto array = env->NewLongArray(MemCategoryCount);
+    if (array)
+        env->SetLongArrayRegion(array, 0, MemCategoryCount, values);
+    return array;
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_gaurav_avnc_vnc_VncClient_nativeTrimMemory(JNIEnv *env, jobject thiz, jlong client_ptr,
+                                                    jboolean aggressive) {
+    requestMemoryTrim(getClientExtension((rfbClient *) client_ptr), aggressive);
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_gaurav_avnc_vnc_VncClient_nativeOnVsync(JNIEnv *env, jobject thiz, jlong client_ptr,
+                                                 jlong frame_time_nanos) {
+    auto client = (rfbClient *) client_ptr;
+    onVsync(&getClientExtension(client)->scheduler, (uint64_t) frame_time_nanos / 1000);
 }
 
 extern "C"
@@ -477,53 +994,116 @@ Java_com_gaurav_avnc_vnc_VncClient_nativeIsEncrypted(JNIEnv *env, jobject thiz,
     return static_cast<jboolean>(((rfbClient *) client_ptr)->tlsSession ? JNI_TRUE : JNI_FALSE);
 }
 
+/**
+ * Uploads given part of the framebuffer to texture.
+ * Caller must hold the framebuffer lock.
+ */
+static void uploadFrameBufferRect(rfbClient *client, ClientEx *ex, UploadRect r) {
+    uploadRectDirect(&ex->texture, &ex->uploads, (uint32_t *) client->frameBuffer, ex->fbRealWidth, r);
+}
+
+/**
+ * Uploads damaged tiles through pixel buffer objects.
+ * Tiles are taken until staging limit is reached.
+ */
+static void uploadTilesWithPbo(rfbClient *client, ClientEx *ex, int planned, int &position, int &uploaded,
+                               uint64_t deadlineUs) {
+    auto texture = &ex->texture;
+    int count = 0;
+
+    while (position < planned && count < MaxStagedTiles) {
+        if (takePlannedTile(&ex->uploads, position++, &texture->tiles[count]))
+            count++;
+    }
+
+    auto fb = (uint32_t *) client->frameBuffer;
+    if (!uploadTilesStaged(texture, &ex->uploads, fb, ex->fbRealWidth, count, deadlineUs)) {
+        for (int i = 0; i < count; ++i)
+            uploadFrameBufferRect(client, ex, texture->tiles[i]);
+    }
+    uploaded += count;
+}
+
 extern "C"
-JNIEXPORT void JNICALL
-Java_com_gaurav_avnc_vnc_VncClient_nativeUploadFrameTexture(JNIEnv *env, jobject thiz,
-                                                            jlong client_ptr) {
+JNIEXPORT jboolean JNICALL
+Java_com_gaurav_avnc_vnc_VncClient_nativeUploadFrameTexture(JNIEnv *env, jobject thiz, jlong client_ptr,
+                                                            jint vx, jint vy, jint vw, jint vh, jint px, jint py) {
     auto client = (rfbClient *) client_ptr;
     auto ex = getClientExtension(client);
+    auto uploads = &ex->uploads;
+    auto startUs = monotonicTimeUs();
+    bool jpegsPending = false;
 
     LOCK(ex->mutex);
 
+    restoreFrameBufferLocked(client);
+
     if (client->frameBuffer) {
-        glTexImage2D(GL_TEXTURE_2D,
-                     0,
-                     GL_RGBA,
-                     ex->fbRealWidth,
-                     ex->fbRealHeight,
-                     0,
-                     GL_RGBA,
-                     GL_UNSIGNED_BYTE,
-                     client->frameBuffer);
-
-        // Note: client->frameBuffer data is actually in 'BGRA' format, instead of 'RGBA'.
-        // But OpenGL ES doesn't support that directly. So we use 'GL_RGBA' here, and flip
-        // the components to correct order inside fragment shader.
+        if (uploads->needsAllocation) {
+            allocateFrameTexture(&ex->texture, ex->fbRealWidth, ex->fbRealHeight);
+            uploads->needsAllocation = false;
+        }
+
+        // Decoding shares the upload budget, so a large backlog can't stall rendering
+        LazyJpegTarget fb = {(uint32_t *) client->frameBuffer, ex->fbRealWidth, ex->fbRealHeight, ex->fbShift,
+                             &ex->detail};
+        jpegsPending = updateLazyJpegViewport(&ex->jpeg, uploads, fb, {vx, vy, vw, vh}, startUs + UploadBudgetUs);
+
+        UploadHints hints = {{vx, vy, vw, vh}, px, py};
+        auto planned = planUploads(uploads, &hints);
+        int position = 0, uploaded = 0;
+        UploadRect rect{};
+
+        if (ex->texture.gles3 && !ex->texture.pboFailed) {
+            uploadTilesWithPbo(client, ex, planned, position, uploaded, startUs + UploadBudgetUs);
+        } else {
+            // At least one tile is uploaded in every frame, to guarantee progress
+            while (position < planned) {
+                if (takePlannedTile(uploads, position++, &rect)) {
+                    uploadFrameBufferRect(client, ex, rect);
+                    uploaded++;
+                }
+                if (monotonicTimeUs() - startUs >= UploadBudgetUs)
+                    break;
+            }
+        }
+
+        finishUploadFrame(uploads, uploaded, planned - position);
     }
 
+    bool pending = client->frameBuffer && (hasPendingUploads(uploads) || jpegsPending);
+    if (!pending)
+        onFrameConsumed(&ex->scheduler);
+
     UNLOCK(ex->mutex);
+    return pending ? JNI_TRUE : JNI_FALSE;
 }
 
 extern "C"
 JNIEXPORT void JNICALL
-Java_com_gaurav_avnc_vnc_VncClient_nativeUploadCursor(JNIEnv *env, jobject thiz, jlong client_ptr, jint px, jint py) {
-
-    auto client = (rfbClient *) client_ptr;
-    auto ex = getClientExtension(client);
-    auto cursor = ex->cursor;
-
-    if (!cursor)
-        return;
-
-    //Current algo for cursor rendering is slightly weird. Main issue is that
-    //glTexSubImage2D() does not perform any composition with target texture.
-    //So, we have to manually blend transparent/invalid pixels of the cursor
-    //with corresponding pixels from framebuffer. scratchBuffer is used for
-    //this composition.
-
+Java_com_gaurav_avnc_vnc_VncClient_nativeResetFrameTexture(JNIEnv *env, jobject thiz, jlong client_ptr,
+                                                           jboolean gles3, jboolean bgra) {
+    auto ex = getClientExtension((rfbClient *) client_ptr);
     LOCK(ex->mutex);
+    resetFrameTexture(&ex->texture, gles3, bgra);
+    invalidateUploadedTexture(&ex->uploads);
+    invalidateUploadedTexture(&ex->detail.uploads);
+    UNLOCK(ex->mutex);
+}
 
+/**
+ * Draws cursor at (px, py) into the texture of given pixels. Texture must be bound,
+ * and cursor rect of [planner] must track where cursor was drawn in it.
+ *
+ * Current algo for cursor rendering is slightly weird. Main issue is that
+ * glTexSubImage2D() does not perform any composition with target texture.
+ * So, we have to manually blend the cursor with corresponding pixels from
+ * framebuffer. Cursor's scratch buffer is used for this composition.
+ *
+ * Caller must hold the framebuffer lock.
+ */
+static void drawCursorLocked(FrameTexture *texture, UploadPlanner *planner, Cursor *cursor,
+                             const uint32_t *fb, int fbWidth, int fbHeight, int px, int py) {
     //Effective cursor position in framebuffer
     int32_t fbCursorX = px - cursor->xHot;
     int32_t fbCursorY = py - cursor->yHot;
@@ -532,50 +1112,126 @@ Java_com_gaurav_avnc_vnc_VncClient_nativeUploadCursor(JNIEnv *env, jobject thiz,
     //Cursor can overflow outside the framebuffer if moved near the edges,
     //but glTexSubImage2D() doesn't allow values outside target texture,
     //so we need to only update the intersection of framebuffer & cursor.
-    int32_t left = -1, top = -1, right = -1, bottom = -1;
+    //Right & bottom are exclusive.
+    int32_t left = fbCursorX > 0 ? fbCursorX : 0;
+    int32_t top = fbCursorY > 0 ? fbCursorY : 0;
+    int32_t right = fbCursorX + cursor->width;
+    int32_t bottom = fbCursorY + cursor->height;
+    if (right > fbWidth) right = fbWidth;
+    if (bottom > fbHeight) bottom = fbHeight;
+
+    auto pixels = cursor->pixels.data;
+    auto scratch = cursor->scratch.data;
+
+    //Texture is no longer re-uploaded in full every frame, so restore the
+    //framebuffer pixels wherever cursor was drawn previously.
+    auto &lastRect = planner->cursorRect;
+    UploadRect newRect = {left, top, right - left, bottom - top};
+    if (!fb || newRect.w <= 0 || newRect.h <= 0)
+        newRect = {0, 0, 0, 0};
+
+    if (memcmp(&lastRect, &newRect, sizeof(UploadRect)) != 0) {
+        if (fb && lastRect.w > 0 && lastRect.h > 0)
+            uploadRectDirect(texture, planner, fb, fbWidth, lastRect);
+        lastRect = newRect;
+    }
 
-    auto fb = (uint32_t *) client->frameBuffer;
-    auto buffer = (uint32_t *) cursor->buffer;
-    auto scratch = (uint32_t *) cursor->scratchBuffer;
-    auto mask = cursor->mask;
-
-    //Scratch buffer index
-    int32_t z = 0;
-
-    for (int32_t y = 0; y < cursor->height; ++y) {
-        for (int32_t x = 0; x < cursor->width; ++x) {
-
-            //Corresponding pixel in framebuffer
-            auto fbX = fbCursorX + x;
-            auto fbY = fbCursorY + y;
-
-            if (fbX >= 0 && fbX < ex->fbRealWidth && fbY >= 0 && fbY < ex->fbRealHeight) {
-                auto isValidPixel = mask[y * cursor->width + x];
-                if (isValidPixel)
-                    scratch[z++] = buffer[y * cursor->width + x];
-                else
-                    scratch[z++] = fb[fbY * ex->fbRealWidth + fbX];
-
-                if (left == -1 && top == -1) {
-                    left = fbX;
-                    top = fbY;
-                }
-                right = fbX;
-                bottom = fbY;
-            }
+    if (fb && pixels && scratch && left < right && top < bottom) {
+        auto width = right - left;
+
+        for (int32_t y = top; y < bottom; ++y) {
+            kernels.blendCursorRow(scratch + (y - top) * width,
+                                   fb + y * fbWidth + left,
+                                   pixels + (y - fbCursorY) * cursor->width + (left - fbCursorX),
+                                   width);
         }
-    }
 
-    if (left >= 0 && top >= 0)
         glTexSubImage2D(GL_TEXTURE_2D,
                         0,
                         left,
                         top,
-                        right - left + 1,
-                        bottom - top + 1,
-                        GL_RGBA,
+                        width,
+                        bottom - top,
+                        texture->format,
                         GL_UNSIGNED_BYTE,
                         scratch);
+    }
+}
 
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_gaurav_avnc_vnc_VncClient_nativeUploadCursor(JNIEnv *env, jobject thiz, jlong client_ptr, jint px, jint py) {
+
+    auto client = (rfbClient *) client_ptr;
+    auto ex = getClientExtension(client);
+    auto cursor = ex->cursor;
+
+    if (!cursor)
+        return;
+
+    LOCK(ex->mutex);
+    drawCursorLocked(&ex->texture, &ex->uploads, cursor, (uint32_t *) client->frameBuffer,
+                     ex->fbRealWidth, ex->fbRealHeight, px, py);
     UNLOCK(ex->mutex);
 }
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_gaurav_avnc_vnc_VncClient_nativeUploadDetailTexture(JNIEnv *env, jobject thiz, jlong client_ptr,
+                                                             jint vx, jint vy, jint vw, jint vh, jfloat scale,
+                                                             jint px, jint py, jboolean draw_cursor,
+                                                             jfloatArray rect_out) {
+    auto client = (rfbClient *) client_ptr;
+    auto ex = getClientExtension(client);
+    auto detail = &ex->detail;
+    auto uploads = &detail->uploads;
+    auto startUs = monotonicTimeUs();
+    jfloat position[4] = {0, 0, 0, 0};
+    bool pending = false;
+
+    LOCK(ex->mutex);
+
+    // Region is needed once a framebuffer pixel is drawn larger than a screen pixel.
+    // client->width might be ahead of the framebuffer, so desktop size is derived from the latter.
+    auto shift = ex->fbShift;
+    UploadRect desktop = {0, 0, ex->fbRealWidth << shift, ex->fbRealHeight << shift};
+    UploadRect viewport = {0, 0, 0, 0};
+    if (client->frameBuffer && shift > 0 && scale > 1)
+        viewport = scaleRectUp({vx, vy, vw, vh}, shift);
+    updateFrameDetailViewport(detail, viewport, desktop, ex->fbBudget / FrameDetailBudgetDivisor / sizeof(uint32_t));
+
+    if (client->frameBuffer && isFrameDetailActive(detail)) {
+        auto r = detail->rect;
+        if (uploads->needsAllocation) {
+            allocateFrameTexture(&ex->texture, r.w, r.h);
+            uploads->needsAllocation = false;
+        }
+
+        auto cursorX = scaleCoordinateUp(px, shift) - r.x;
+        auto cursorY = scaleCoordinateUp(py, shift) - r.y;
+
+        UploadHints hints = {{0, 0, r.w, r.h}, cursorX, cursorY};
+        auto planned = planUploads(uploads, &hints);
+        UploadRect tile{};
+        for (int i = 0; i < planned && monotonicTimeUs() - startUs < UploadBudgetUs; ++i) {
+            if (takePlannedTile(uploads, i, &tile))
+                uploadRectDirect(&ex->texture, uploads, detail->pixels, r.w, tile);
+        }
+
+        if (draw_cursor && detail->cursor)
+            drawCursorLocked(&ex->texture, uploads, detail->cursor, detail->pixels, r.w, r.h, cursorX, cursorY);
+
+        pending = hasPendingUploads(uploads);
+
+        auto unit = (float) (1 << shift);
+        position[0] = (float) r.x / unit;
+        position[1] = (float) r.y / unit;
+        position[2] = (float) r.w / unit;
+        position[3] = (float) r.h / unit;
+    }
+
+    UNLOCK(ex->mutex);
+
+    env->SetFloatArrayRegion(rect_out, 0, 4, position);
+    return pending ? JNI_TRUE : JNI_FALSE;
+}
@@ -204,6 +204,7 @@ data class ServerProfile(
         private const val FLAG_BUTTON_UP_DELAY = 0x02L
         private const val FLAG_ZOOM_LOCKED = 0x04L
         const val FLAG_CONNECT_ON_APP_START = 0x08L
+        private const val FLAG_PREFER_H264 = 0x10L
     }
 
     /**
@@ -240,4 +241,11 @@ data class ServerProfile(
      */
     @IgnoredOnParcel
     var fConnectOnAppStart by Flag(FLAG_CONNECT_ON_APP_START)
+
+    /**
+     * Ask server to use Open H.264 encoding for framebuffer updates.
+     * Ignored if [useRawEncoding] is enabled.
+     */
+    @IgnoredOnParcel
+    var fPreferH264 by Flag(FLAG_PREFER_H264)
 }
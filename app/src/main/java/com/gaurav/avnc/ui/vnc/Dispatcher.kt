@@ -12,7 +12,6 @@ import android.graphics.PointF
 import com.gaurav.avnc.viewmodel.VncViewModel
 import com.gaurav.avnc.vnc.Messenger
 import com.gaurav.avnc.vnc.PointerButton
-import kotlin.math.abs
 
 /**
  * We allow users to customize the actions for different events.
@@ -157,6 +156,7 @@ class Dispatcher(private val activity: VncActivity) {
     fun onStylusScroll(p: PointF) = directMode.doButtonDown(PointerButton.Left, p)
 
     fun onXKey(keySym: Int, xtCode: Int, isDown: Boolean) = messenger.sendKey(keySym, xtCode, isDown)
+    fun onAndroidKey(keyCode: Int, scanCode: Int, isDown: Boolean) = messenger.sendAndroidKey(keyCode, scanCode, isDown)
 
     fun onGestureStyleChanged() {
         config = Config()
@@ -220,27 +220,15 @@ class Dispatcher(private val activity: VncActivity) {
             accumulatedDx += dx
             accumulatedDy += dy * yScrollDirection
 
-            //Drain horizontal change
-            while (abs(accumulatedDx) >= deltaPerScroll) {
-                if (accumulatedDx > 0) {
-                    doClick(PointerButton.WheelLeft, focus)
-                    accumulatedDx -= deltaPerScroll
-                } else {
-                    doClick(PointerButton.WheelRight, focus)
-                    accumulatedDx += deltaPerScroll
-                }
-            }
+            //Drain accumulated change as wheel ticks
+            //Positive ticks are Left/Up, negative are Right/Down
+            val hTicks = (accumulatedDx / deltaPerScroll).toInt()
+            val vTicks = (accumulatedDy / deltaPerScroll).toInt()
+            accumulatedDx -= hTicks * deltaPerScroll
+            accumulatedDy -= vTicks * deltaPerScroll
 
-            //Drain vertical change
-            while (abs(accumulatedDy) >= deltaPerScroll) {
-                if (accumulatedDy > 0) {
-                    doClick(PointerButton.WheelUp, focus)
-                    accumulatedDy -= deltaPerScroll
-                } else {
-                    doClick(PointerButton.WheelDown, focus)
-                    accumulatedDy += deltaPerScroll
-                }
-            }
+            if (hTicks != 0 || vTicks != 0)
+                transformPoint(focus)?.let { messenger.sendScroll(it, hTicks, vTicks) }
         }
 
         /**
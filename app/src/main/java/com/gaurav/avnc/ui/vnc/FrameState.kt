@@ -9,9 +9,12 @@
 package com.gaurav.avnc.ui.vnc
 
 import android.graphics.PointF
+import android.graphics.Rect
 import android.graphics.RectF
 import com.gaurav.avnc.ui.vnc.FrameState.Snapshot
 import kotlin.math.abs
+import kotlin.math.ceil
+import kotlin.math.floor
 import kotlin.math.max
 import kotlin.math.min
 
@@ -152,7 +155,22 @@ class FrameState(
             val vpWidth: Float,
             val vpHeight: Float,
             val scale: Float
-    )
+    ) {
+        /**
+         * Returns the part of framebuffer which is visible in viewport.
+         */
+        fun getVisibleFbRect(): Rect {
+            if (scale <= 0F)
+                return Rect()
+
+            val left = (-frameX / scale).coerceIn(0F, fbWidth)
+            val top = (-frameY / scale).coerceIn(0F, fbHeight)
+            val right = ((vpWidth - frameX) / scale).coerceIn(0F, fbWidth)
+            val bottom = ((vpHeight - frameY) / scale).coerceIn(0F, fbHeight)
+
+            return Rect(floor(left).toInt(), floor(top).toInt(), ceil(right).toInt(), ceil(bottom).toInt())
+        }
+    }
 
     private val lock = Any()
     private inline fun <T> withLock(block: () -> T) = synchronized(lock) { block() }
@@ -247,6 +265,11 @@ class FrameState(
         return PointF(fbPoint.x * scale + frameX, fbPoint.y * scale + frameY)
     }
 
+    /**
+     * Returns the part of framebuffer which is currently visible in viewport.
+     */
+    fun getVisibleFbRect() = getSnapshot().getVisibleFbRect()
+
     /**
      * Returns immutable & consistent snapshot of frame state.
      */
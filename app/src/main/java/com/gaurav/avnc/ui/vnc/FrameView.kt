@@ -9,11 +9,13 @@
 package com.gaurav.avnc.ui.vnc
 
 import android.annotation.SuppressLint
+import android.app.ActivityManager
 import android.content.Context
 import android.opengl.GLSurfaceView
 import android.os.Build
 import android.os.SystemClock
 import android.util.AttributeSet
+import android.view.Choreographer
 import android.view.KeyEvent
 import android.view.MotionEvent
 import android.view.PointerIcon
@@ -49,6 +51,8 @@ class FrameView(context: Context?, attrs: AttributeSet? = null) : GLSurfaceView(
 
     private lateinit var touchHandler: TouchHandler
     private lateinit var keyHandler: KeyHandler
+    private lateinit var client: VncClient
+    private val vsyncTracker = VsyncTracker()
 
     /**
      * Input connection used for intercepting key events
@@ -72,6 +76,38 @@ class FrameView(context: Context?, attrs: AttributeSet? = null) : GLSurfaceView(
         }
     }
 
+    /**
+     * Reports display refresh timestamps to [VncClient], which uses them to
+     * time framebuffer update requests.
+     *
+     * To avoid waking up on every frame, timestamps are only tracked for
+     * a few frames after each render request.
+     */
+    private inner class VsyncTracker : Choreographer.FrameCallback {
+        private val trackedFrames = 4
+        private var framesLeft = 0
+
+        // Called on main thread
+        override fun doFrame(frameTimeNanos: Long) {
+            client.onVsync(frameTimeNanos)
+            if (--framesLeft > 0)
+                Choreographer.getInstance().postFrameCallback(this)
+        }
+
+        fun start() {
+            if (framesLeft <= 0)
+                Choreographer.getInstance().postFrameCallback(this)
+            framesLeft = trackedFrames
+        }
+    }
+
+    private val startVsyncTracker = Runnable { vsyncTracker.start() }
+
+    override fun requestRender() {
+        super.requestRender()
+        post(startVsyncTracker)
+    }
+
     /**
      * Should be called from [VncActivity.onCreate].
      */
@@ -80,8 +116,12 @@ class FrameView(context: Context?, attrs: AttributeSet? = null) : GLSurfaceView(
 
         touchHandler = activity.touchHandler
         keyHandler = activity.keyHandler
+        client = viewModel.client
 
-        setEGLContextClientVersion(2)
+        // GLES3 is preferred for pixel buffer objects, see native FrameTexture.
+        // Shaders are written in GLSL ES 1.0, which works with both versions.
+        val activityManager = context.getSystemService(Context.ACTIVITY_SERVICE) as ActivityManager
+        setEGLContextClientVersion(if (activityManager.deviceConfigurationInfo.reqGlEsVersion >= 0x30000) 3 else 2)
         setRenderer(Renderer(viewModel))
         renderMode = RENDERMODE_WHEN_DIRTY
 
@@ -153,8 +153,6 @@ class KeyHandler(private val dispatcher: Dispatcher, private val cfLegacyKeysym:
      * It will call [emitForAndroidKeyCode] or [emitForUnicodeChar] depending on arguments.
      */
     private fun emitForKeyEvent(keyCode: Int, unicodeChar: Int, isDown: Boolean, scanCode: Int = 0): Boolean {
-        val xtCode = if (scanCode == 0) 0 else XTKeyCode.fromAndroidScancode(scanCode)
-
         if (handleDiacritics(keyCode, unicodeChar, isDown))
             return true
 
@@ -165,7 +163,7 @@ class KeyHandler(private val dispatcher: Dispatcher, private val cfLegacyKeysym:
             KeyEvent.KEYCODE_NUMPAD_ENTER,
             KeyEvent.KEYCODE_SPACE,
             KeyEvent.KEYCODE_TAB ->
-                return emitForAndroidKeyCode(keyCode, isDown, xtCode)
+                return emitForAndroidKeyCode(keyCode, isDown, scanCode)
         }
 
         // We prefer to use unicodeChar even when keyCode is available because
@@ -174,20 +172,30 @@ class KeyHandler(private val dispatcher: Dispatcher, private val cfLegacyKeysym:
         // it works well with these servers.
 
         if (unicodeChar != 0)
-            return emitForUnicodeChar(unicodeChar, isDown, xtCode)
+            return emitForUnicodeChar(unicodeChar, isDown, getXTCode(scanCode))
         else
-            return emitForAndroidKeyCode(keyCode, isDown, xtCode)
+            return emitForAndroidKeyCode(keyCode, isDown, scanCode)
     }
 
     /**
      * Emits X KeySym corresponding to [keyCode]
      */
-    private fun emitForAndroidKeyCode(keyCode: Int, isDown: Boolean, xtCode: Int = 0): Boolean {
-        var keySym = XKeySymAndroid.getKeySymForAndroidKeyCode(keyCode)
-        keySym = overrideXKeySym(keySym)
-        return emit(keySym, isDown, xtCode)
+    private fun emitForAndroidKeyCode(keyCode: Int, isDown: Boolean, scanCode: Int = 0): Boolean {
+        val keySym = XKeySymAndroid.getKeySymForAndroidKeyCode(keyCode)
+        if (keySym == 0)
+            return false
+
+        // Common case is translated in native code, where both the KeySym & XT code
+        // are looked up without additional JNI calls.
+        val overriddenKeySym = overrideXKeySym(keySym)
+        if (overriddenKeySym == keySym)
+            return dispatcher.onAndroidKey(keyCode, scanCode, isDown)
+
+        return emit(overriddenKeySym, isDown, getXTCode(scanCode))
     }
 
+    private fun getXTCode(scanCode: Int) = if (scanCode == 0) 0 else XTKeyCode.fromAndroidScancode(scanCode)
+
     /**
      * Emits either Unicode KeySym or legacy KeySym for [uChar], depending on [cfLegacyKeysym].
      */
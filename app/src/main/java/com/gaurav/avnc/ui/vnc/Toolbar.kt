@@ -62,6 +62,7 @@ class Toolbar(private val activity: VncActivity, private val dispatcher: Dispatc
 
     fun initialize() {
         binding.keyboardBtn.setOnClickListener { activity.showKeyboard(); close() }
+        binding.keyboardBtn.setOnLongClickListener { viewModel.typeClipboardText(); close(); true }
         binding.zoomOptions.setOnLongClickListener { resetZoomToDefault(); close(); true }
         binding.zoomResetBtn.setOnClickListener { resetZoomToDefault(); close() }
         binding.zoomResetBtn.setOnLongClickListener { resetZoom(); close(); true }
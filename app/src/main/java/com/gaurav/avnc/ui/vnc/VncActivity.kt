@@ -10,11 +10,14 @@ package com.gaurav.avnc.ui.vnc
 
 import android.app.Activity
 import android.app.PictureInPictureParams
+import android.content.BroadcastReceiver
 import android.content.ClipboardManager
 import android.content.Context
 import android.content.Intent
+import android.content.IntentFilter
 import android.content.pm.ActivityInfo
 import android.content.res.Configuration
+import android.os.BatteryManager
 import android.os.Build
 import android.os.Bundle
 import android.os.Parcelable
@@ -97,6 +100,11 @@ class VncActivity : AppCompatActivity() {
     private var restoredFromBundle = false
     private var wasConnectedWhenStopped = false
     private var onStartTime = 0L
+    private val batteryReceiver = object : BroadcastReceiver() {
+        override fun onReceive(context: Context, intent: Intent) {
+            viewModel.setOnBattery(intent.getIntExtra(BatteryManager.EXTRA_PLUGGED, 0) == 0)
+        }
+    }
 
     override fun onCreate(savedInstanceState: Bundle?) {
         DeviceAuthPrompt.applyFingerprintDialogFix(supportFragmentManager)
@@ -138,12 +146,14 @@ class VncActivity : AppCompatActivity() {
         viewModel.resumeFrameBufferUpdates()
         onStartTime = SystemClock.uptimeMillis()
 
-        // Refresh framebuffer on activity restart:
-        // - It forces read/write on the socket. This allows us to verify the socket, which might have
-        //   been closed by the server while app process was frozen in background
-        // - It also attempts to fix some unusual cases of old updates requests being lost while AVNC
-        //   was frozen by the system
-        if (wasConnectedWhenStopped) viewModel.refreshFrameBuffer()
+        // Sticky broadcast, so receiver is immediately called with current status
+        ContextCompat.registerReceiver(this, batteryReceiver, IntentFilter(Intent.ACTION_BATTERY_CHANGED),
+                                       ContextCompat.RECEIVER_NOT_EXPORTED)
+
+        // No full refresh is needed on restart. Resuming updates (above) sends a request for the
+        // visible region, followed by regular requests. This forces read/write on the socket, which
+        // verifies it (server might have closed it while app process was frozen in background), and
+        // replaces any old update requests lost while AVNC was frozen by the system.
     }
 
     override fun onStop() {
@@ -151,9 +161,15 @@ class VncActivity : AppCompatActivity() {
         virtualKeys.releaseMetaKeys()
         binding.frameView.onPause()
         viewModel.pauseFrameBufferUpdates()
+        unregisterReceiver(batteryReceiver)
         wasConnectedWhenStopped = viewModel.state.value.isConnected
     }
 
+    override fun onTrimMemory(level: Int) {
+        super.onTrimMemory(level)
+        viewModel.onTrimMemory(level)
+    }
+
     override fun onSaveInstanceState(outState: Bundle) {
         super.onSaveInstanceState(outState)
         outState.putParcelable(PROFILE_KEY, viewModel.profile)
@@ -345,7 +361,7 @@ class VncActivity : AppCompatActivity() {
     override fun onWindowFocusChanged(hasFocus: Boolean) {
         super.onWindowFocusChanged(hasFocus)
         layoutManager.onWindowFocusChanged(hasFocus)
-        if (hasFocus) viewModel.sendClipboardText()
+        viewModel.onAppFocusChanged(hasFocus)
         toggleClipboardListener(hasFocus)
     }
 
@@ -28,6 +28,9 @@ import java.nio.FloatBuffer
  *            [0, 0]  +-----------+  [fbWidth, 0]
  *
  * Frame texture is mapped onto these triangles.
+ *
+ * A frame can also cover only a part of framebuffer (see [updateFbRect]),
+ * which is used for drawing full resolution region of a downsampled framebuffer.
  */
 class Frame {
 
@@ -38,6 +41,8 @@ class Frame {
         const val STRIDE = (TRIANGLE_COMPONENT + TEXTURE_COMPONENT) * FLOAT_SIZE
     }
 
+    private var fbX = 0F
+    private var fbY = 0F
     private var fbWidth = 0F
     private var fbHeight = 0F
     private var vertexData: FloatArray
@@ -61,14 +66,14 @@ class Frame {
 
         return floatArrayOf(
                 //@formatter:off
-                //Triangle coordinates     //Texture coordinates
-                0F, 0F,                    0F, 0F,
-                fbWidth, 0F,               1F, 0F,
-                fbWidth, fbHeight,         1F, 1F,
-
-                0F, 0F,                    0F, 0F,
-                fbWidth, fbHeight,         1F, 1F,
-                0F, fbHeight,              0F, 1F
+                //Triangle coordinates              //Texture coordinates
+                fbX, fbY,                           0F, 0F,
+                fbX + fbWidth, fbY,                 1F, 0F,
+                fbX + fbWidth, fbY + fbHeight,      1F, 1F,
+
+                fbX, fbY,                           0F, 0F,
+                fbX + fbWidth, fbY + fbHeight,      1F, 1F,
+                fbX, fbY + fbHeight,                0F, 1F
                 //@formatter:on
         )
     }
@@ -90,10 +95,17 @@ class Frame {
      * Should be called whenever the size of framebuffer is changed.
      * This size will be used to calculate frame vertices.
      */
-    fun updateFbSize(width: Float, height: Float) {
-        if (width == fbWidth && height == fbHeight)
+    fun updateFbSize(width: Float, height: Float) = updateFbRect(0F, 0F, width, height)
+
+    /**
+     * Sets the part of framebuffer covered by this frame.
+     */
+    fun updateFbRect(x: Float, y: Float, width: Float, height: Float) {
+        if (x == fbX && y == fbY && width == fbWidth && height == fbHeight)
             return //Nothing to do
 
+        fbX = x
+        fbY = y
         fbWidth = width
         fbHeight = height
 
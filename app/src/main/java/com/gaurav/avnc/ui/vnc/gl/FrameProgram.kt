@@ -32,8 +32,10 @@ import com.gaurav.avnc.BuildConfig
  * Represents the GL program used for Frame rendering.
  *
  * NOTE: It must be instantiated in an OpenGL context.
+ *
+ * [bgraTexture] should be true if frame texture is in BGRA format.
  */
-class FrameProgram {
+class FrameProgram(bgraTexture: Boolean) {
 
     companion object {
         // Attribute constants
@@ -45,12 +47,14 @@ class FrameProgram {
         const val U_TEXTURE_UNIT = "u_TextureUnit"
     }
 
-    val program = ShaderCompiler.buildProgram(Shaders.VERTEX_SHADER, Shaders.FRAGMENT_SHADER)
+    val program = ShaderCompiler.buildProgram(Shaders.VERTEX_SHADER,
+                                              if (bgraTexture) Shaders.FRAGMENT_SHADER_BGRA_TEXTURE else Shaders.FRAGMENT_SHADER)
     val aPositionLocation = glGetAttribLocation(program, A_POSITION)
     val aTextureCoordinatesLocation = glGetAttribLocation(program, A_TEXTURE_COORDINATES)
     val uProjectionLocation = glGetUniformLocation(program, U_PROJECTION)
     val uTexUnitLocation = glGetUniformLocation(program, U_TEXTURE_UNIT)
     val textureId = createTexture()
+    val detailTextureId = createTexture()
     var validated = false
 
 
@@ -61,6 +65,14 @@ class FrameProgram {
         glUniform1i(uTexUnitLocation, 0)
     }
 
+    /**
+     * Binds the texture used for full resolution region of a downsampled
+     * framebuffer. Frame texture is bound again by [setUniforms].
+     */
+    fun bindDetailTexture() {
+        glBindTexture(GL_TEXTURE_2D, detailTextureId)
+    }
+
     private fun createTexture(): Int {
         val texturesObjects = intArrayOf(0)
         glGenTextures(1, texturesObjects, 0)
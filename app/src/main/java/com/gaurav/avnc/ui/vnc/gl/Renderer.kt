@@ -9,8 +9,11 @@
 package com.gaurav.avnc.ui.vnc.gl
 
 import android.opengl.GLES20.GL_COLOR_BUFFER_BIT
+import android.opengl.GLES20.GL_EXTENSIONS
+import android.opengl.GLES20.GL_VERSION
 import android.opengl.GLES20.glClear
 import android.opengl.GLES20.glClearColor
+import android.opengl.GLES20.glGetString
 import android.opengl.GLES20.glViewport
 import android.opengl.GLSurfaceView
 import android.opengl.Matrix
@@ -27,12 +30,22 @@ class Renderer(val viewModel: VncViewModel) : GLSurfaceView.Renderer {
     private val hideCursor = viewModel.pref.input.hideRemoteCursor
     private lateinit var program: FrameProgram
     private lateinit var frame: Frame
+    private lateinit var detailFrame: Frame
+    private val detailRect = FloatArray(4)
+    private var isGLES3 = false
+    private var hasBGRATexture = false
+    private var textureReset = false
 
     override fun onSurfaceCreated(gl: GL10?, config: EGLConfig?) {
         glClearColor(0f, 0f, 0f, 1f)
 
+        isGLES3 = glGetString(GL_VERSION)?.startsWith("OpenGL ES 3") == true
+        hasBGRATexture = glGetString(GL_EXTENSIONS)?.contains("GL_EXT_texture_format_BGRA8888") == true
+
         frame = Frame()
-        program = FrameProgram()
+        detailFrame = Frame()
+        program = FrameProgram(hasBGRATexture)
+        textureReset = false
     }
 
     override fun onSurfaceChanged(gl: GL10?, width: Int, height: Int) {
@@ -89,7 +102,15 @@ class Renderer(val viewModel: VncViewModel) : GLSurfaceView.Renderer {
         program.useProgram()
         program.setUniforms(projectionMatrix)
 
-        viewModel.client.uploadFrameTexture()
+        // Native side may have uploaded to texture of a previous context
+        if (!textureReset) {
+            viewModel.client.resetFrameTexture(isGLES3, hasBGRATexture)
+            textureReset = true
+        }
+
+        val visibleRect = state.getVisibleFbRect()
+        if (viewModel.client.uploadFrameTexture(visibleRect))
+            viewModel.frameViewRef.get()?.requestRender()
         if (!hideCursor) viewModel.client.uploadCursor()
 
         frame.updateFbSize(state.fbWidth, state.fbHeight)
@@ -97,5 +118,16 @@ class Renderer(val viewModel: VncViewModel) : GLSurfaceView.Renderer {
 
         program.validate()
         frame.draw()
+
+        // Full resolution region is drawn over the frame, when zoomed in on a downsampled framebuffer
+        program.bindDetailTexture()
+        if (viewModel.client.uploadDetailTexture(visibleRect, state.scale, !hideCursor, detailRect))
+            viewModel.frameViewRef.get()?.requestRender()
+
+        if (detailRect[2] > 0f) {
+            detailFrame.updateFbRect(detailRect[0], detailRect[1], detailRect[2], detailRect[3])
+            detailFrame.bind(program)
+            detailFrame.draw()
+        }
     }
 }
\ No newline at end of file
@@ -24,6 +24,9 @@ object Shaders {
                gl_Position = u_Projection * vec4(a_Position, 0, 1);
             }"""
 
+    /**
+     * Used when framebuffer is uploaded as RGBA, but actually contains BGRA data.
+     */
     //language=GLSL
     const val FRAGMENT_SHADER = """
             precision mediump float;
@@ -33,4 +36,17 @@ object Shaders {
             {
                gl_FragColor = texture2D(u_TextureUnit, v_TextureCoordinates).bgra;
             }"""
+
+    /**
+     * Used when framebuffer is uploaded as BGRA (GL_EXT_texture_format_BGRA8888).
+     */
+    //language=GLSL
+    const val FRAGMENT_SHADER_BGRA_TEXTURE = """
+            precision mediump float;
+            uniform sampler2D u_TextureUnit;
+            varying vec2 v_TextureCoordinates;
+            void main()
+            {
+               gl_FragColor = texture2D(u_TextureUnit, v_TextureCoordinates);
+            }"""
 }
\ No newline at end of file
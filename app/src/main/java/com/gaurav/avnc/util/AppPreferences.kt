@@ -34,6 +34,8 @@ class AppPreferences(context: Context) {
         val pipEnabled; get() = prefs.getBoolean("pip_enabled", false)
         val drawBehindCutout; get() = prefs.getBoolean("viewer_draw_behind_cutout", false)
         val keepScreenOn; get() = prefs.getBoolean("keep_screen_on", true)
+        val batteryFpsLimit; get() = prefs.getString("viewer_battery_fps_limit", "30")!!.toInt()
+        val renderLead; get() = prefs.getString("viewer_render_lead", "1")!!.toInt()
         val toolbarAlignment; get() = prefs.getString("toolbar_alignment", "start")
         val toolbarOpenWithSwipe; get() = prefs.getBoolean("toolbar_open_with_swipe", true)
         val zoomMax; get() = prefs.getInt("zoom_max", 500) / 100F
@@ -72,10 +74,12 @@ class AppPreferences(context: Context) {
         val kmLanguageSwitchToSuper; get() = prefs.getBoolean("km_language_switch_to_super", false)
         val kmRightAltToSuper; get() = prefs.getBoolean("km_right_alt_to_super", false)
         val kmBackToEscape; get() = prefs.getBoolean("km_back_to_escape", false)
+        val kmTypeTextRate; get() = prefs.getString("km_type_text_rate", "200")!!.toInt()
     }
 
     inner class Server {
         val clipboardSync; get() = prefs.getBoolean("clipboard_sync", true)
+        val clipboardMaxSize; get() = prefs.getString("clipboard_max_size", "1024")!!.toInt() * 1024
         val lockSavedServer; get() = prefs.getBoolean("lock_saved_server", false)
         val autoReconnect; get() = prefs.getBoolean("auto_reconnect", false)
         val discoveryAutorun; get() = prefs.getBoolean("discovery_autorun", true)
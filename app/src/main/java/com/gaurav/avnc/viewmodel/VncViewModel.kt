@@ -8,7 +8,10 @@
 
 package com.gaurav.avnc.viewmodel
 
+import android.app.ActivityManager
 import android.app.Application
+import android.content.ComponentCallbacks2
+import android.content.Context
 import android.graphics.RectF
 import android.util.Log
 import android.widget.Toast
@@ -37,6 +40,7 @@ import kotlinx.coroutines.runBlocking
 import java.io.IOException
 import java.lang.ref.WeakReference
 import kotlin.concurrent.thread
+import kotlin.math.max
 
 /**
  * ViewModel for VncActivity
@@ -208,13 +212,29 @@ class VncViewModel(val profile: ServerProfile, app: Application) : BaseViewModel
         }
     }
 
+    /**
+     * Framebuffers of very large desktops can exhaust memory on small devices,
+     * so framebuffer size is limited according to available RAM.
+     */
+    private fun getFrameBufferBudget(): Long {
+        val am = app.getSystemService(Context.ACTIVITY_SERVICE) as ActivityManager
+        if (am.isLowRamDevice)
+            return 32L * 1024 * 1024
+
+        val memInfo = ActivityManager.MemoryInfo().also { am.getMemoryInfo(it) }
+        return max(64L * 1024 * 1024, memInfo.totalMem / 16)
+    }
+
     private fun preConnect() {
         if (profile.ID != 0L && pref.server.lockSavedServer)
             if (!serverUnlockRequest.requestResponse(null))
                 throw IOException("Could not unlock server")
 
         client.configure(profile.viewOnly, profile.securityType, true  /* Hardcoded to true */,
-                         profile.imageQuality, profile.useRawEncoding)
+                         profile.imageQuality, profile.useRawEncoding, profile.fPreferH264)
+
+        client.setMaxCutTextSize(pref.server.clipboardMaxSize)
+        client.setFrameBufferBudget(getFrameBufferBudget())
 
         if (profile.useRepeater)
             client.setupRepeater(profile.idOnRepeater)
@@ -243,6 +263,8 @@ class VncViewModel(val profile: ServerProfile, app: Application) : BaseViewModel
         }
 
         state.postValue(State.Connected)
+        applyFrameRateLimit()
+        client.setRenderLead(pref.viewer.renderLead)
 
         // Initial sync, slightly delayed to allow extended clipboard negotiations
         launchIO { delay(1000L); sendClipboardText() }
@@ -342,6 +364,34 @@ class VncViewModel(val profile: ServerProfile, app: Application) : BaseViewModel
         }
     }
 
+    /**
+     * With extended clipboard, server only announces its clipboard changes, and the text
+     * is fetched when we are likely to need it: when user leaves the app (e.g. to paste
+     * it somewhere else). Changes made while app is in background are fetched right away.
+     */
+    @Volatile
+    private var isAppFocused = true
+
+    fun onAppFocusChanged(hasFocus: Boolean) {
+        isAppFocused = hasFocus
+        if (hasFocus) sendClipboardText()
+        else fetchServerClipboardText()
+    }
+
+    private fun fetchServerClipboardText() {
+        if (pref.server.clipboardSync && client.connected)
+            messenger.requestClipboardText()
+    }
+
+    /**
+     * Types local clipboard text on the server, for servers without clipboard support.
+     */
+    fun typeClipboardText() {
+        if (client.connected) launchIO {
+            getClipboardText(app)?.let { messenger.typeText(it, pref.input.kmTypeTextRate) }
+        }
+    }
+
     private var clipReceiverJob: Job? = null
     private fun receiveClipboardText(text: String) {
         if (!pref.server.clipboardSync)
@@ -377,29 +427,71 @@ class VncViewModel(val profile: ServerProfile, app: Application) : BaseViewModel
         return loginInfoRequest.requestResponse(type)  // Blocking call
     }
 
+    private var resizeJob: Job? = null
+
     /**
      * Resize remote desktop to match with local window size (if requested by user).
      * In portrait mode, safe area is used instead of window to exclude the keyboard.
      */
     fun resizeRemoteDesktop() {
-        if (profile.resizeRemoteDesktop) frameState.let {
-            if (it.windowWidth > it.windowHeight)
-                messenger.setDesktopSize(it.windowWidth.toInt(), it.windowHeight.toInt())
-            else
-                messenger.setDesktopSize(it.safeArea.width().toInt(), it.safeArea.height().toInt())
+        if (!profile.resizeRemoteDesktop)
+            return
+
+        // Layout changes usually come in bursts (e.g. during rotation or keyboard animation),
+        // so wait for the layout to settle. Native code further ensures that only one resize
+        // request is in-flight at a time.
+        resizeJob?.cancel()
+        resizeJob = launchMain {
+            delay(300L)
+            frameState.let {
+                if (it.windowWidth > it.windowHeight)
+                    messenger.setDesktopSize(it.windowWidth.toInt(), it.windowHeight.toInt())
+                else
+                    messenger.setDesktopSize(it.safeArea.width().toInt(), it.safeArea.height().toInt())
+            }
         }
     }
 
     fun pauseFrameBufferUpdates() {
-        //client.setAutomaticFrameBufferUpdates(false)
+        client.setAutomaticFrameBufferUpdates(false)
     }
 
+    /**
+     * Visible part of the frame is requested first, so that it is updated as soon
+     * as possible. Rest of the frame is requested once automatic updates resume.
+     */
     fun resumeFrameBufferUpdates() {
-        //client.setAutomaticFrameBufferUpdates(true)
+        client.setAutomaticFrameBufferUpdates(true)
+
+        val visibleRect = frameState.getVisibleFbRect()
+        if (!visibleRect.isEmpty)
+            messenger.requestFrameBufferUpdate(visibleRect)
     }
 
-    fun refreshFrameBuffer() {
-        messenger.refreshFrameBuffer()
+    /**
+     * Whether device is running on battery, updated by [VncActivity].
+     */
+    @Volatile
+    private var onBattery = false
+
+    fun setOnBattery(value: Boolean) {
+        onBattery = value
+        applyFrameRateLimit()
+    }
+
+    private fun applyFrameRateLimit() {
+        client.setFrameRateLimit(if (onBattery) pref.viewer.batteryFpsLimit else 0)
+    }
+
+    /**
+     * Called by [VncActivity] when system is running low on memory.
+     */
+    fun onTrimMemory(level: Int) {
+        if (level < ComponentCallbacks2.TRIM_MEMORY_RUNNING_LOW || !client.connected)
+            return
+
+        Log.i(javaClass.simpleName, "Trimming memory (level $level), native usage: ${client.getMemoryUsage()}")
+        client.trimMemory(level >= ComponentCallbacks2.TRIM_MEMORY_BACKGROUND)
     }
 
     /**************************************************************************
@@ -422,6 +514,11 @@ class VncViewModel(val profile: ServerProfile, app: Application) : BaseViewModel
         receiveClipboardText(text)
     }
 
+    override fun onServerClipboardAvailable() {
+        if (!isAppFocused)
+            fetchServerClipboardText()
+    }
+
     override fun onFramebufferSizeChanged(width: Int, height: Int) {
         launchMain {
             frameState.setFramebufferSize(width.toFloat(), height.toFloat())
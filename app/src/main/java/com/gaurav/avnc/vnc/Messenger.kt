@@ -9,9 +9,11 @@
 package com.gaurav.avnc.vnc
 
 import android.graphics.PointF
+import android.graphics.Rect
 import android.util.Log
 import java.util.concurrent.Executors
 import java.util.concurrent.TimeUnit
+import java.util.concurrent.atomic.AtomicInteger
 
 /**
  * Allows sending different types of messages to remote server.
@@ -33,6 +35,7 @@ class Messenger(private val client: VncClient) {
     }
 
     fun cleanup() {
+        cancelTyping()
         synchronized(senderLock) { sender.shutdown() }
         runCatching { sender.awaitTermination(60, TimeUnit.SECONDS) }
         if (!sender.isTerminated) Log.w(javaClass.simpleName, "Unable to fully stop Sender thread!")
@@ -72,6 +75,17 @@ class Messenger(private val client: VncClient) {
         }
     }
 
+    /**
+     * Sends scroll wheel ticks. See [VncClient.queueScroll].
+     */
+    fun sendScroll(p: PointF, hTicks: Int, vTicks: Int) {
+        val x = p.x.toInt()
+        val y = p.y.toInt()
+        client.moveClientPointer(x, y)
+        if (client.queueScroll(x, y, pointerButtonMask, hTicks, vTicks))
+            execute { client.flushScroll() }
+    }
+
     fun sendKey(keySym: Int, xtCode: Int, isDown: Boolean): Boolean {
         if (!client.connected)
             return false
@@ -80,6 +94,53 @@ class Messenger(private val client: VncClient) {
         return true
     }
 
+    fun sendAndroidKey(keyCode: Int, scanCode: Int, isDown: Boolean): Boolean {
+        if (!client.connected)
+            return false
+
+        execute { client.sendAndroidKeyEvent(keyCode, scanCode, isDown) }
+        return true
+    }
+
+    /**
+     * Typing is done in small chunks, each queued on the sender thread after previous one
+     * completes. This allows other events to be sent in between, instead of everything
+     * waiting until whole text is typed. Starting a new typing job cancels the previous one.
+     */
+    private val typingJob = AtomicInteger()
+
+    fun typeText(text: String, rateLimit: Int) {
+        val job = typingJob.incrementAndGet()
+        val capped = if (text.length > MAX_TYPE_TEXT_LENGTH) {
+            Log.w(javaClass.simpleName, "Typing only first $MAX_TYPE_TEXT_LENGTH of ${text.length} characters")
+            text.substring(0, text.offsetByCodePoints(0, text.codePointCount(0, MAX_TYPE_TEXT_LENGTH)))
+        } else text
+
+        // At most ~100ms worth of typing per chunk
+        val chunkSize = if (rateLimit > 0) (rateLimit / 10).coerceAtLeast(1) else TYPE_TEXT_CHUNK_SIZE
+        typeTextChunk(job, capped, 0, chunkSize, rateLimit)
+    }
+
+    private fun typeTextChunk(job: Int, text: String, start: Int, chunkSize: Int, rateLimit: Int) {
+        if (start >= text.length || job != typingJob.get())
+            return
+
+        var end = text.offsetByCodePoints(start, minOf(chunkSize, text.codePointCount(start, text.length)))
+        if (end < text.length && text[end - 1] == '\r' && text[end] == '\n')
+            ++end // Keep CR-LF together, it is typed as single Return
+
+        execute {
+            if (job == typingJob.get()) {
+                client.typeText(text.substring(start, end), rateLimit)
+                typeTextChunk(job, text, end, chunkSize, rateLimit)
+            }
+        }
+    }
+
+    fun cancelTyping() {
+        typingJob.incrementAndGet()
+    }
+
     fun insertButtonUpDelay() {
         execute { runCatching { Thread.sleep(200) } }
     }
@@ -92,6 +153,10 @@ class Messenger(private val client: VncClient) {
         execute { client.sendCutText(text) }
     }
 
+    fun requestClipboardText() {
+        execute { client.requestServerCutText() }
+    }
+
     fun setDesktopSize(width: Int, height: Int) {
         execute { client.setDesktopSize(width, height) }
     }
@@ -99,4 +164,16 @@ class Messenger(private val client: VncClient) {
     fun refreshFrameBuffer() {
         execute { client.refreshFrameBuffer() }
     }
-}
\ No newline at end of file
+
+    fun requestFrameBufferUpdate(rect: Rect) {
+        execute { client.requestFrameBufferUpdate(rect.left, rect.top, rect.width(), rect.height()) }
+    }
+
+    companion object {
+        // Longer texts are truncated before typing
+        const val MAX_TYPE_TEXT_LENGTH = 16 * 1024
+
+        // Characters per chunk when typing is not rate-limited
+        private const val TYPE_TEXT_CHUNK_SIZE = 256
+    }
+}
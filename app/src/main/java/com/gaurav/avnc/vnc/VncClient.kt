@@ -1,5 +1,6 @@
 package com.gaurav.avnc.vnc
 
+import android.graphics.Rect
 import android.view.KeyEvent
 import androidx.annotation.Keep
 import java.io.IOException
@@ -42,6 +43,7 @@ class VncClient(private val observer: Observer) {
         fun onPasswordRequired(): String
         fun onCredentialRequired(): UserCredential
         fun onGotXCutText(text: String)
+        fun onServerClipboardAvailable()
         fun onFramebufferUpdated()
         fun onFramebufferSizeChanged(width: Int, height: Int)
         fun onPointerMoved(x: Int, y: Int)
@@ -49,6 +51,23 @@ class VncClient(private val observer: Observer) {
         //fun onBell()
     }
 
+    /**
+     * Native memory held by a client, in bytes.
+     * Memory held inside some libraries (zlib, TurboJPEG, TLS) is estimated.
+     */
+    data class MemoryUsage(
+            val frameBuffer: Long,
+            val hibernated: Long,
+            val cursor: Long,
+            val scratch: Long,
+            val decoderState: Long,
+            val queues: Long,
+            val tls: Long,
+            val bookkeeping: Long
+    ) {
+        val total get() = frameBuffer + hibernated + cursor + scratch + decoderState + queues + tls + bookkeeping
+    }
+
     /**
      * Value of the pointer to native 'rfbClient'. This is passed to all native methods.
      */
@@ -116,20 +135,45 @@ class VncClient(private val observer: Observer) {
     @Volatile
     private var lastCutText: String? = null
 
+    private var maxCutTextSize = 0
+
     /**
      * Setup different properties for this client.
      *
      * @param securityType RFB security type to use.
+     * @param useH264 Whether Open H.264 encoding should be preferred over others.
      */
-    fun configure(viewOnly: Boolean, securityType: Int, useLocalCursor: Boolean, imageQuality: Int, useRawEncoding: Boolean) {
+    fun configure(viewOnly: Boolean, securityType: Int, useLocalCursor: Boolean, imageQuality: Int, useRawEncoding: Boolean,
+                  useH264: Boolean) {
         viewOnlyMode = viewOnly
-        nativeConfigure(nativePtr, securityType, useLocalCursor, imageQuality, useRawEncoding)
+        nativeConfigure(nativePtr, securityType, useLocalCursor, imageQuality, useRawEncoding, useH264)
     }
 
     fun setupRepeater(serverId: Int) {
         nativeSetDest(nativePtr, "ID", serverId)
     }
 
+    /**
+     * Limits the size of cut text exchanged with server, in both directions.
+     * Larger text is dropped without being copied around.
+     *
+     * @param maxBytes Maximum size in bytes, non-positive value removes the limit.
+     */
+    fun setMaxCutTextSize(maxBytes: Int) {
+        maxCutTextSize = maxBytes
+        nativeSetMaxCutTextSize(nativePtr, maxBytes)
+    }
+
+    /**
+     * Sets the memory budget for framebuffer. Framebuffers larger than this
+     * are stored at reduced resolution. Must be called before [connect].
+     *
+     * @param bytes Budget in bytes, non-positive value removes the limit.
+     */
+    fun setFrameBufferBudget(bytes: Long) {
+        nativeSetFrameBufferBudget(nativePtr, bytes)
+    }
+
     /**
      * Initializes VNC connection.
      */
@@ -169,6 +213,28 @@ class VncClient(private val observer: Observer) {
         nativeSendKeyEvent(nativePtr, keySym, xtCode, isDown)
     }
 
+    /**
+     * Sends Key event to remote server, translating Android key codes in native code.
+     *
+     * @param keyCode   Key code from [android.view.KeyEvent]
+     * @param scanCode  Scan code from [android.view.KeyEvent], 0 if not available
+     * @param isDown    true for key down, false for key up
+     */
+    fun sendAndroidKeyEvent(keyCode: Int, scanCode: Int, isDown: Boolean) = ifConnectedAndInteractive {
+        nativeSendAndroidKeyEvent(nativePtr, keyCode, scanCode, isDown)
+    }
+
+    /**
+     * Types [text] on remote server by sending key events for each character.
+     * This will block until whole text is sent, so long texts should be split
+     * (see [Messenger.typeText]).
+     *
+     * @param rateLimit Max number of characters per second, 0 for no limit
+     */
+    fun typeText(text: String, rateLimit: Int) = ifConnectedAndInteractive {
+        nativeTypeText(nativePtr, text.toByteArray(StandardCharsets.UTF_8), rateLimit)
+    }
+
     /**
      * Sends pointer event to remote server.
      *
@@ -180,6 +246,25 @@ class VncClient(private val observer: Observer) {
         nativeSendPointerEvent(nativePtr, x, y, mask)
     }
 
+    /**
+     * Queues scroll wheel ticks, to be sent later by [flushScroll].
+     * Ticks are accumulated in native code, so this can be called frequently.
+     *
+     * @param hTicks  Horizontal ticks, positive for left & negative for right
+     * @param vTicks  Vertical ticks, positive for up & negative for down
+     * @return true if a call to [flushScroll] should be scheduled
+     */
+    fun queueScroll(x: Int, y: Int, mask: Int, hTicks: Int, vTicks: Int): Boolean {
+        return connected && !viewOnlyMode && nativeQueueScroll(nativePtr, x, y, mask, hTicks, vTicks)
+    }
+
+    /**
+     * Sends all pending scroll ticks to server in a single write.
+     */
+    fun flushScroll() = ifConnectedAndInteractive {
+        nativeFlushScroll(nativePtr)
+    }
+
     /**
      * Updates client-side pointer position.
      * No event is sent to server.
@@ -205,7 +290,11 @@ class VncClient(private val observer: Observer) {
      * Sends text to remote desktop's clipboard.
      */
     fun sendCutText(text: String) = ifConnectedAndInteractive {
-        if (text != lastCutText) {
+        // Encoded text is at least as long as the string, so obviously large strings
+        // are skipped without encoding them. Exact size is checked in native code.
+        val tooLarge = maxCutTextSize > 0 && text.length > maxCutTextSize
+
+        if (text != lastCutText && !tooLarge) {
             val sent = if (nativeIsUTF8CutTextSupported(nativePtr))
                 nativeSendCutText(nativePtr, text.toByteArray(StandardCharsets.UTF_8), true)
             else
@@ -215,6 +304,14 @@ class VncClient(private val observer: Observer) {
         }
     }
 
+    /**
+     * Fetches server's clipboard text, if server has announced a change since last fetch.
+     * Text is delivered via [Observer.onGotXCutText].
+     */
+    fun requestServerCutText() = ifConnected {
+        nativeRequestServerCutText(nativePtr)
+    }
+
     /**
      * Set remote desktop size to given dimensions.
      * This needs server support to actually work.
@@ -236,15 +333,93 @@ class VncClient(private val observer: Observer) {
      * Controls whether framebuffer update requests are sent automatically.
      * It takes effect after the next call to [processServerMessage].
      */
-    /*fun setAutomaticFrameBufferUpdates(enabled: Boolean) = ifConnected {
-        //autoFBRequestsQueued = enabled
-    }*/
+    fun setAutomaticFrameBufferUpdates(enabled: Boolean) = ifConnected {
+        autoFBRequestsQueued = enabled
+    }
+
+    /**
+     * Sends an incremental update request for given framebuffer region.
+     */
+    fun requestFrameBufferUpdate(x: Int, y: Int, w: Int, h: Int) = ifConnected {
+        nativeRequestFrameBufferUpdate(nativePtr, x, y, w, h)
+    }
+
+    /**
+     * Limits framebuffer update requests to [fps] per second, 0 for no limit.
+     * Limit is temporarily lifted after user input.
+     */
+    fun setFrameRateLimit(fps: Int) = ifConnected {
+        nativeSetFrameRateLimit(nativePtr, fps)
+    }
+
+    /**
+     * Sets how many received frames the renderer can fall behind before next
+     * update request is delayed. Default is 1, which gives the lowest latency.
+     * Higher values allow more updates in flight on high-latency connections.
+     */
+    fun setRenderLead(frames: Int) = ifConnected {
+        nativeSetRenderLead(nativePtr, frames)
+    }
+
+    /**
+     * Reports display refresh timestamp, as received in [android.view.Choreographer.FrameCallback].
+     * It is used to time framebuffer update requests.
+     */
+    fun onVsync(frameTimeNanos: Long) = ifConnected {
+        nativeOnVsync(nativePtr, frameTimeNanos)
+    }
 
     /**
      * Puts framebuffer contents in currently active OpenGL texture.
      * Must be called from an OpenGL ES context (i.e. from renderer thread).
+     *
+     * Only damaged parts are uploaded, within a per-frame time budget. Parts in [visibleRect],
+     * and near the pointer, are uploaded first. Returns true if some parts are still pending,
+     * i.e. another frame should be rendered.
      */
-    fun uploadFrameTexture() = nativeUploadFrameTexture(nativePtr)
+    fun uploadFrameTexture(visibleRect: Rect) = with(visibleRect) {
+        nativeUploadFrameTexture(nativePtr, left, top, width(), height(), pointerX, pointerY)
+    }
+
+    /**
+     * Puts full resolution region of a downsampled framebuffer in currently active
+     * OpenGL texture. Must be called from renderer thread, after [uploadFrameTexture].
+     *
+     * Region is only kept while framebuffer is zoomed in beyond its density, i.e. [scale]
+     * (screen pixels per framebuffer pixel) is more than 1. Its position, in framebuffer
+     * coordinates, is returned in [rect] as [x, y, width, height]. Width is 0 if there
+     * is nothing to draw. Return value has same meaning as in [uploadFrameTexture].
+     */
+    fun uploadDetailTexture(visibleRect: Rect, scale: Float, drawCursor: Boolean, rect: FloatArray) = with(visibleRect) {
+        nativeUploadDetailTexture(nativePtr, left, top, width(), height(), scale, pointerX, pointerY, drawCursor, rect)
+    }
+
+    /**
+     * Should be called when texture contents are lost, e.g. on new OpenGL context.
+     * Whole framebuffer will be uploaded again on next [uploadFrameTexture].
+     *
+     * If [isGLES3] is true, pixel buffer objects are used for uploads.
+     * If [hasBGRATexture] is true, texture is created in BGRA format.
+     */
+    fun resetFrameTexture(isGLES3: Boolean, hasBGRATexture: Boolean) = ifConnected {
+        nativeResetFrameTexture(nativePtr, isGLES3, hasBGRATexture)
+    }
+
+    /**
+     * Returns native memory used by this client.
+     */
+    fun getMemoryUsage() = nativeGetMemoryUsage(nativePtr).let {
+        MemoryUsage(it[0], it[1], it[2], it[3], it[4], it[5], it[6], it[7])
+    }
+
+    /**
+     * Frees scratch buffers & idle decoder state. Trim is done asynchronously, by the thread
+     * processing server messages. If [aggressive] is true, and framebuffer updates are paused,
+     * framebuffer is also hibernated.
+     */
+    fun trimMemory(aggressive: Boolean) = ifConnected {
+        nativeTrimMemory(nativePtr, aggressive)
+    }
 
     /**
      * Upload cursor shape into framebuffer texture.
@@ -271,23 +446,40 @@ class VncClient(private val observer: Observer) {
     }
 
     private external fun nativeClientCreate(): Long
-    private external fun nativeConfigure(clientPtr: Long, securityType: Int, useLocalCursor: Boolean, imageQuality: Int, useRawEncoding: Boolean)
+    private external fun nativeConfigure(clientPtr: Long, securityType: Int, useLocalCursor: Boolean, imageQuality: Int, useRawEncoding: Boolean,
+                                         useH264: Boolean)
     private external fun nativeInit(clientPtr: Long, host: String, port: Int): Boolean
     private external fun nativeSetDest(clientPtr: Long, host: String, port: Int)
     private external fun nativeProcessServerMessage(clientPtr: Long, uSecTimeout: Int): Boolean
     private external fun nativeSendKeyEvent(clientPtr: Long, keySym: Int, xtCode: Int, isDown: Boolean): Boolean
+    private external fun nativeSendAndroidKeyEvent(clientPtr: Long, keyCode: Int, scanCode: Int, isDown: Boolean): Boolean
+    private external fun nativeTypeText(clientPtr: Long, utf8Bytes: ByteArray, rateLimit: Int): Boolean
     private external fun nativeSendPointerEvent(clientPtr: Long, x: Int, y: Int, mask: Int): Boolean
+    private external fun nativeQueueScroll(clientPtr: Long, x: Int, y: Int, mask: Int, hTicks: Int, vTicks: Int): Boolean
+    private external fun nativeFlushScroll(clientPtr: Long): Boolean
     private external fun nativeSendCutText(clientPtr: Long, bytes: ByteArray, isUTF8: Boolean): Boolean
+    private external fun nativeSetMaxCutTextSize(clientPtr: Long, maxSize: Int)
+    private external fun nativeSetRenderLead(clientPtr: Long, frames: Int)
+    private external fun nativeSetFrameBufferBudget(clientPtr: Long, bytes: Long)
+    private external fun nativeGetMemoryUsage(clientPtr: Long): LongArray
+    private external fun nativeTrimMemory(clientPtr: Long, aggressive: Boolean)
+    private external fun nativeRequestServerCutText(clientPtr: Long): Boolean
     private external fun nativeIsUTF8CutTextSupported(clientPtr: Long): Boolean
     private external fun nativeSetDesktopSize(clientPtr: Long, width: Int, height: Int): Boolean
     private external fun nativeRefreshFrameBuffer(clientPtr: Long): Boolean
+    private external fun nativeRequestFrameBufferUpdate(clientPtr: Long, x: Int, y: Int, w: Int, h: Int): Boolean
     private external fun nativeSetAutomaticFramebufferUpdates(clientPtr: Long, enabled: Boolean)
     private external fun nativeGetDesktopName(clientPtr: Long): String
     private external fun nativeGetWidth(clientPtr: Long): Int
     private external fun nativeGetHeight(clientPtr: Long): Int
     private external fun nativeIsEncrypted(clientPtr: Long): Boolean
-    private external fun nativeUploadFrameTexture(clientPtr: Long)
+    private external fun nativeSetFrameRateLimit(clientPtr: Long, fps: Int)
+    private external fun nativeOnVsync(clientPtr: Long, frameTimeNanos: Long)
+    private external fun nativeUploadFrameTexture(clientPtr: Long, vx: Int, vy: Int, vw: Int, vh: Int, px: Int, py: Int): Boolean
+    private external fun nativeResetFrameTexture(clientPtr: Long, isGLES3: Boolean, hasBGRATexture: Boolean)
     private external fun nativeUploadCursor(clientPtr: Long, px: Int, py: Int)
+    private external fun nativeUploadDetailTexture(clientPtr: Long, vx: Int, vy: Int, vw: Int, vh: Int, scale: Float,
+                                                  px: Int, py: Int, drawCursor: Boolean, rect: FloatArray): Boolean
     private external fun nativeGetLastErrorStr(): String
     private external fun nativeIsServerMacOS(clientPtr: Long): Boolean
     private external fun nativeCleanup(clientPtr: Long)
@@ -298,10 +490,14 @@ class VncClient(private val observer: Observer) {
     @Keep
     private fun cbGetCredential() = observer.onCredentialRequired()
 
+    /**
+     * [buffer] wraps native memory, and is only valid during this call.
+     * Duplicate texts are filtered out in native code before reaching here.
+     */
     @Keep
-    private fun cbGotXCutText(bytes: ByteArray, isUTF8: Boolean) {
+    private fun cbGotXCutText(buffer: ByteBuffer, isUTF8: Boolean) {
         (if (isUTF8) StandardCharsets.UTF_8 else StandardCharsets.ISO_8859_1).let {
-            val cutText = it.decode(ByteBuffer.wrap(bytes)).toString()
+            val cutText = it.decode(buffer).toString()
             if (cutText != lastCutText) {
                 lastCutText = cutText
                 observer.onGotXCutText(cutText)
@@ -309,6 +505,13 @@ class VncClient(private val observer: Observer) {
         }
     }
 
+    /**
+     * Server's clipboard has changed, but the text is only sent when requested.
+     * See [requestServerCutText].
+     */
+    @Keep
+    private fun cbServerClipboardAvailable() = observer.onServerClipboardAvailable()
+
     @Keep
     private fun cbFinishedFrameBufferUpdate() = observer.onFramebufferUpdated()
 
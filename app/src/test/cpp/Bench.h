@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_TEST_BENCH_H
+#define AVNC_TEST_BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * Minimal helpers for host benchmarks.
+ */
+
+static uint64_t benchNowNs() {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * Runs [fn] [iterations] times (after a short warm-up), and returns average ns per iteration.
+ */
+template<typename Fn>
+static double benchRun(uint64_t iterations, Fn fn) {
+    for (uint64_t i = 0; i < iterations / 10 + 1; ++i)
+        fn(i);
+
+    auto start = benchNowNs();
+    for (uint64_t i = 0; i < iterations; ++i)
+        fn(i);
+    return (double) (benchNowNs() - start) / (double) iterations;
+}
+
+/**
+ * Runs [a] & [b] alternately with benchRun() for [rounds] rounds, and returns the
+ * fastest average of each. Alternating & taking the best make comparisons far
+ * less sensitive to noise from other load on the machine.
+ */
+template<typename FnA, typename FnB>
+static void benchCompare(uint64_t rounds, uint64_t iterations, FnA a, FnB b, double *aNs, double *bNs) {
+    *aNs = *bNs = 1e300;
+    for (uint64_t r = 0; r < rounds; ++r) {
+        auto ta = benchRun(iterations, a);
+        auto tb = benchRun(iterations, b);
+        if (ta < *aNs) *aNs = ta;
+        if (tb < *bNs) *bNs = tb;
+    }
+}
+
+// Keeps results alive, so that the compiler can't drop benchmarked code
+static volatile uint64_t benchSink;
+
+#endif //AVNC_TEST_BENCH_H
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+/**
+ * Cost of YUV to BGRX conversion (ColorConvert.h) for a 1080p frame, per megapixel.
+ */
+
+#include <stdlib.h>
+#include "Bench.h"
+#include "ColorConvert.h"
+
+static const int Width = 1920;
+static const int Height = 1080;
+
+typedef void (*ConvertRow)(uint32_t *dst, const uint8_t *yRow, const uint8_t *uRow, const uint8_t *vRow,
+                           int uStep, int width);
+
+static uint8_t *yPlane, *uPlane, *vPlane, *uvPlane;
+static uint32_t *frame;
+
+static void convertPlanar(ConvertRow convert) {
+    for (int row = 0; row < Height; ++row) {
+        auto chroma = (size_t) (row / 2) * (Width / 2);
+        convert(frame + (size_t) row * Width, yPlane + (size_t) row * Width, uPlane + chroma, vPlane + chroma, 1, Width);
+    }
+}
+
+static void convertSemiPlanar(ConvertRow convert) {
+    for (int row = 0; row < Height; ++row) {
+        auto chroma = uvPlane + (size_t) (row / 2) * Width;
+        convert(frame + (size_t) row * Width, yPlane + (size_t) row * Width, chroma, chroma + 1, 2, Width);
+    }
+}
+
+static double usPerMegapixel(double nsPerFrame) {
+    return nsPerFrame / 1000 / ((double) Width * Height / 1e6);
+}
+
+static void report(const char *name, ConvertRow convert) {
+    const uint64_t n = 100;
+    auto planar = benchRun(n, [&](uint64_t) { convertPlanar(convert); });
+    auto semiPlanar = benchRun(n, [&](uint64_t) { convertSemiPlanar(convert); });
+    benchSink = frame[Width * Height / 2];
+
+    printf("%-7s I420: %7.1f us/MP, NV12: %7.1f us/MP\n", name, usPerMegapixel(planar), usPerMegapixel(semiPlanar));
+}
+
+int main() {
+    yPlane = (uint8_t *) malloc((size_t) Width * Height);
+    uPlane = (uint8_t *) malloc((size_t) Width * Height / 4);
+    vPlane = (uint8_t *) malloc((size_t) Width * Height / 4);
+    uvPlane = (uint8_t *) malloc((size_t) Width * Height / 2);
+    frame = (uint32_t *) malloc((size_t) Width * Height * sizeof(uint32_t));
+
+    srand(1);
+    for (size_t i = 0; i < (size_t) Width * Height; ++i)
+        yPlane[i] = (uint8_t) rand();
+    for (size_t i = 0; i < (size_t) Width * Height / 4; ++i) {
+        uvPlane[2 * i] = uPlane[i] = (uint8_t) rand();
+        uvPlane[2 * i + 1] = vPlane[i] = (uint8_t) rand();
+    }
+
+    report("scalar", yuvRowToBGRXScalar);
+#if defined(__ARM_NEON)
+    report("neon", yuvRowToBGRXNeon);
+#elif defined(__SSE2__)
+    report("sse2", yuvRowToBGRXSSE2);
+#endif
+
+    free(yPlane);
+    free(uPlane);
+    free(vPlane);
+    free(uvPlane);
+    free(frame);
+    return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#include "Test.h"
+#include "ColorConvert.h"
+
+/**
+ * Checks vector YUV to BGRX conversion (ColorConvert.h) against the scalar
+ * version, for every possible Y, U & V combination.
+ */
+
+#if defined(__ARM_NEON)
+static const char *VectorName = "neon";
+static auto yuvRowToBGRXVector = yuvRowToBGRXNeon;
+#elif defined(__SSE2__)
+static const char *VectorName = "sse2";
+static auto yuvRowToBGRXVector = yuvRowToBGRXSSE2;
+#else
+static const char *VectorName = "scalar";
+static auto yuvRowToBGRXVector = yuvRowToBGRXScalar;
+#endif
+
+static uint32_t convertOne(uint8_t y, uint8_t u, uint8_t v) {
+    uint32_t pixel;
+    yuvRowToBGRXScalar(&pixel, &y, &u, &v, 1, 1);
+    return pixel;
+}
+
+static void referenceColours() {
+    EXPECT_EQ(0x000000u, convertOne(16, 128, 128));  // Black
+    EXPECT_EQ(0xffffffu, convertOne(235, 128, 128)); // White
+    EXPECT_EQ(0xff0000u, convertOne(81, 90, 240));   // Red
+    EXPECT_EQ(0x00ff01u, convertOne(145, 54, 34));   // Green, with rounding error of 8-bit YUV
+    EXPECT_EQ(0x0000ffu, convertOne(41, 240, 110));  // Blue
+
+    // Out of range inputs are clamped
+    EXPECT_EQ(0x000000u, convertOne(0, 128, 128));
+    EXPECT_EQ(0xffffffu, convertOne(255, 128, 128));
+}
+
+/**
+ * Each row has all 256 Y values, with fixed U & V. Rows cover all U & V values.
+ */
+static void allInputsMatchScalar() {
+    static uint8_t y[256], u[128], v[128];
+    static uint32_t expected[256], actual[256];
+    int mismatches = 0;
+
+    for (int i = 0; i < 256; ++i)
+        y[i] = (uint8_t) i;
+
+    for (int cu = 0; cu < 256; ++cu) {
+        memset(u, cu, sizeof(u));
+        for (int cv = 0; cv < 256; ++cv) {
+            memset(v, cv, sizeof(v));
+            yuvRowToBGRXScalar(expected, y, u, v, 1, 256);
+            yuvRowToBGRXVector(actual, y, u, v, 1, 256);
+
+            for (int i = 0; i < 256; ++i) {
+                if (expected[i] != actual[i] && ++mismatches <= 8)
+                    fprintf(stderr, "%s: YUV (%d, %d, %d): %06x vs %06x\n",
+                            VectorName, i, cu, cv, expected[i], actual[i]);
+            }
+        }
+    }
+    EXPECT_EQ(0, mismatches);
+}
+
+/**
+ * Widths around vector size, with random input. The same chroma is passed as
+ * planar & as interleaved, which must produce the same output.
+ */
+static void rowTailsAndLayoutsMatch() {
+    const int MaxWidth = 72;
+    static uint8_t y[MaxWidth], u[MaxWidth / 2], v[MaxWidth / 2], uv[MaxWidth];
+    static uint32_t expected[MaxWidth + 1], planar[MaxWidth + 1], semiPlanar[MaxWidth + 1];
+
+    for (int width = 0; width <= MaxWidth; ++width) {
+        for (int i = 0; i < MaxWidth; ++i)
+            y[i] = (uint8_t) testRandom();
+        for (int i = 0; i < MaxWidth / 2; ++i) {
+            uv[2 * i] = u[i] = (uint8_t) testRandom();
+            uv[2 * i + 1] = v[i] = (uint8_t) testRandom();
+        }
+
+        expected[width] = planar[width] = semiPlanar[width] = 0xdeadbeef;
+        yuvRowToBGRXScalar(expected, y, u, v, 1, width);
+        yuvRowToBGRXVector(planar, y, u, v, 1, width);
+        yuvRowToBGRXVector(semiPlanar, y, uv, uv + 1, 2, width);
+
+        EXPECT(memcmp(expected, planar, (width + 1) * sizeof(uint32_t)) == 0);
+        EXPECT(memcmp(expected, semiPlanar, (width + 1) * sizeof(uint32_t)) == 0);
+    }
+}
+
+int main() {
+    printf("Vector: %s\n", VectorName);
+
+    RUN_TEST(referenceColours);
+    RUN_TEST(allInputsMatchScalar);
+    RUN_TEST(rowTailsAndLayoutsMatch);
+    return testResult();
+}
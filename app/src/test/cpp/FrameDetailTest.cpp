@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#include <jni.h>
+#include "Test.h"
+#include "Utility.h"
+#include "FrameDetail.h"
+
+// Desktop of 4000x2000, stored at half resolution
+static const int Shift = 1;
+static const int FbWidth = 2000;
+static const int FbHeight = 1000;
+static const UploadRect Desktop = {0, 0, FbWidth << Shift, FbHeight << Shift};
+static const size_t MaxPixels = 1000 * 1000;
+
+static void fillRow(uint32_t *dst, uint32_t colour, int count) {
+    for (int i = 0; i < count; ++i)
+        dst[i] = colour;
+}
+
+static uint32_t *newFrameBuffer() {
+    auto fb = (uint32_t *) malloc((size_t) FbWidth * FbHeight * sizeof(uint32_t));
+    for (size_t i = 0; i < (size_t) FbWidth * FbHeight; ++i)
+        fb[i] = (uint32_t) i;
+    return fb;
+}
+
+static void noRegionWhenNotZoomed() {
+    FrameDetail detail;
+    initFrameDetail(&detail);
+
+    UploadRect rect;
+    updateFrameDetailViewport(&detail, {0, 0, 0, 0}, Desktop, MaxPixels);
+    EXPECT(!takeFrameDetailRequest(&detail, &rect));
+    destroyFrameDetail(&detail);
+}
+
+static void regionCoversViewportWithSlack() {
+    FrameDetail detail;
+    initFrameDetail(&detail);
+
+    UploadRect rect, next;
+    UploadRect viewport = {1000, 1000, 400, 300};
+    updateFrameDetailViewport(&detail, viewport, Desktop, MaxPixels);
+    EXPECT(takeFrameDetailRequest(&detail, &rect));
+    EXPECT(rectContains(rect, viewport));
+    EXPECT(rect.w > viewport.w && rect.h > viewport.h);
+
+    // Small pan stays inside current region
+    updateFrameDetailViewport(&detail, {1010, 1005, 400, 300}, Desktop, MaxPixels);
+    EXPECT(!takeFrameDetailRequest(&detail, &next));
+
+    // Large pan moves it
+    updateFrameDetailViewport(&detail, {1300, 1000, 400, 300}, Desktop, MaxPixels);
+    EXPECT(takeFrameDetailRequest(&detail, &next));
+    EXPECT(rectContains(next, {1300, 1000, 400, 300}));
+
+    // Zooming out drops it
+    updateFrameDetailViewport(&detail, {0, 0, 0, 0}, Desktop, MaxPixels);
+    EXPECT(takeFrameDetailRequest(&detail, &next));
+    EXPECT(isRectEmpty(next));
+    destroyFrameDetail(&detail);
+}
+
+static void largeViewportIsLimitedToBudget() {
+    FrameDetail detail;
+    initFrameDetail(&detail);
+
+    UploadRect rect;
+    updateFrameDetailViewport(&detail, Desktop, Desktop, MaxPixels);
+    EXPECT(takeFrameDetailRequest(&detail, &rect));
+    EXPECT((size_t) rect.w * rect.h <= MaxPixels);
+    EXPECT(rectContains(Desktop, rect));
+
+    // Center is kept
+    EXPECT(rect.x < Desktop.w / 2 && rect.x + rect.w > Desktop.w / 2);
+    EXPECT(rect.y < Desktop.h / 2 && rect.y + rect.h > Desktop.h / 2);
+
+    // Same viewport doesn't request again
+    updateFrameDetailViewport(&detail, Desktop, Desktop, MaxPixels);
+    EXPECT(!takeFrameDetailRequest(&detail, &rect));
+    destroyFrameDetail(&detail);
+}
+
+static void newRegionIsFilledFromFrameBuffer() {
+    FrameDetail detail;
+    initFrameDetail(&detail);
+    auto fb = newFrameBuffer();
+
+    UploadRect missing[4];
+    EXPECT_EQ(1, setFrameDetailRegionLocked(&detail, {100, 100, 50, 40}, fb, FbWidth, Shift, missing));
+    EXPECT_EQ(100, missing[0].x);
+    EXPECT_EQ(50, missing[0].w);
+    EXPECT_EQ(fb[(120 >> Shift) * FbWidth + (131 >> Shift)], *getFrameDetailPixel(&detail, 131, 120));
+    EXPECT(hasPendingUploads(&detail.uploads));
+
+    free(fb);
+    destroyFrameDetail(&detail);
+}
+
+static void writesAreClippedToRegion() {
+    FrameDetail detail;
+    initFrameDetail(&detail);
+    auto fb = newFrameBuffer();
+    UploadRect missing[4];
+    setFrameDetailRegionLocked(&detail, {100, 100, 50, 40}, fb, FbWidth, Shift, missing);
+
+    uint32_t block[20 * 20];
+    fillRow(block, 7, 20 * 20);
+    writeFrameDetail(&detail, block, 20, {90, 90, 20, 20});
+    EXPECT_EQ(7u, *getFrameDetailPixel(&detail, 100, 100));
+    EXPECT_EQ(7u, *getFrameDetailPixel(&detail, 109, 109));
+    EXPECT(*getFrameDetailPixel(&detail, 110, 110) != 7u);
+
+    fillFrameDetail(&detail, {140, 130, 100, 100}, 9);
+    EXPECT_EQ(9u, *getFrameDetailPixel(&detail, 149, 139));
+    EXPECT(*getFrameDetailPixel(&detail, 139, 139) != 9u);
+
+    // Source inside region
+    copyFrameDetail(&detail, fb, FbWidth, Shift, 100, 100, 5, 5, 120, 120);
+    EXPECT_EQ(7u, *getFrameDetailPixel(&detail, 124, 124));
+
+    // Source outside region comes from framebuffer
+    copyFrameDetail(&detail, fb, FbWidth, Shift, 0, 0, 4, 4, 100, 100);
+    EXPECT_EQ(fb[(101 >> Shift) * FbWidth + (101 >> Shift)], *getFrameDetailPixel(&detail, 101, 101));
+
+    free(fb);
+    destroyFrameDetail(&detail);
+}
+
+static void movedRegionKeepsSharedPixels() {
+    FrameDetail detail;
+    initFrameDetail(&detail);
+    auto fb = newFrameBuffer();
+    UploadRect missing[4];
+    setFrameDetailRegionLocked(&detail, {100, 100, 50, 40}, fb, FbWidth, Shift, missing);
+    fillFrameDetail(&detail, {100, 100, 50, 40}, 5);
+
+    auto count = setFrameDetailRegionLocked(&detail, {120, 110, 50, 40}, fb, FbWidth, Shift, missing);
+    EXPECT_EQ(2, count);
+
+    int area = 0;
+    for (int i = 0; i < count; ++i)
+        area += missing[i].w * missing[i].h;
+    EXPECT_EQ(50 * 40 - 30 * 30, area);
+
+    EXPECT_EQ(5u, *getFrameDetailPixel(&detail, 120, 110));
+    EXPECT_EQ(5u, *getFrameDetailPixel(&detail, 149, 139));
+    EXPECT(*getFrameDetailPixel(&detail, 150, 140) != 5u);
+
+    releaseFrameDetailLocked(&detail);
+    EXPECT(!isFrameDetailActive(&detail));
+
+    free(fb);
+    destroyFrameDetail(&detail);
+}
+
+int main() {
+    kernels.fillRow = fillRow;
+
+    RUN_TEST(noRegionWhenNotZoomed);
+    RUN_TEST(regionCoversViewportWithSlack);
+    RUN_TEST(largeViewportIsLimitedToBudget);
+    RUN_TEST(newRegionIsFilledFromFrameBuffer);
+    RUN_TEST(writesAreClippedToRegion);
+    RUN_TEST(movedRegionKeepsSharedPixels);
+    return testResult();
+}
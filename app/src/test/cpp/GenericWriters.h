@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_TEST_GENERICWRITERS_H
+#define AVNC_TEST_GENERICWRITERS_H
+
+#include <string.h>
+#include <rfb/rfbclient.h>
+
+/**
+ * Equivalents of LibVNCClient's default framebuffer writers (FillRectangle,
+ * CopyRectangle & CopyRectangleFromRectangle in rfbproto.c), which are used
+ * for any pixel format other than ours. Like the originals, they branch on
+ * bits-per-pixel on every call, and fill & CopyRect go pixel by pixel.
+ *
+ * These are the reference for specialised writers in PixelWriter.h.
+ */
+
+template<typename Pixel>
+static void genericFill(rfbClient *client, int x, int y, int w, int h, uint32_t colour) {
+    auto fb = (Pixel *) client->frameBuffer;
+    for (int j = y * client->width; j < (y + h) * client->width; j += client->width)
+        for (int i = x; i < x + w; ++i)
+            fb[j + i] = (Pixel) colour;
+}
+
+static void genericFillRect(rfbClient *client, int x, int y, int w, int h, uint32_t colour) {
+    switch (client->format.bitsPerPixel) {
+        case 8: genericFill<uint8_t>(client, x, y, w, h, colour); break;
+        case 16: genericFill<uint16_t>(client, x, y, w, h, colour); break;
+        case 32: genericFill<uint32_t>(client, x, y, w, h, colour); break;
+    }
+}
+
+static void genericCopyBitmap(rfbClient *client, const uint8_t *buffer, int x, int y, int w, int h) {
+    int bytesPerPixel = client->format.bitsPerPixel / 8;
+    if (bytesPerPixel != 1 && bytesPerPixel != 2 && bytesPerPixel != 4)
+        return;
+
+    int rowBytes = w * bytesPerPixel, stride = client->width * bytesPerPixel;
+    for (int j = x * bytesPerPixel + y * stride; j < (y + h) * stride; j += stride) {
+        memcpy(client->frameBuffer + j, buffer, rowBytes);
+        buffer += rowBytes;
+    }
+}
+
+template<typename Pixel>
+static void genericCopy(rfbClient *client, int srcX, int srcY, int w, int h, int dstX, int dstY) {
+    auto fb = (Pixel *) client->frameBuffer;
+    auto src = fb + (srcY - dstY) * client->width + srcX - dstX;
+    auto width = client->width;
+
+    // Iterate in the direction which doesn't overwrite source pixels before they are read
+    auto copyRow = [&](int j) {
+        if (dstX < srcX) {
+            for (int i = dstX; i < dstX + w; ++i) fb[j + i] = src[j + i];
+        } else {
+            for (int i = dstX + w - 1; i >= dstX; --i) fb[j + i] = src[j + i];
+        }
+    };
+
+    if (dstY < srcY) {
+        for (int j = dstY * width; j < (dstY + h) * width; j += width) copyRow(j);
+    } else {
+        for (int j = (dstY + h - 1) * width; j >= dstY * width; j -= width) copyRow(j);
+    }
+}
+
+static void genericCopyRect(rfbClient *client, int srcX, int srcY, int w, int h, int dstX, int dstY) {
+    switch (client->format.bitsPerPixel) {
+        case 8: genericCopy<uint8_t>(client, srcX, srcY, w, h, dstX, dstY); break;
+        case 16: genericCopy<uint16_t>(client, srcX, srcY, w, h, dstX, dstY); break;
+        case 32: genericCopy<uint32_t>(client, srcX, srcY, w, h, dstX, dstY); break;
+    }
+}
+
+#endif //AVNC_TEST_GENERICWRITERS_H
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#include <jni.h>
+#include "Test.h"
+#include "Kernels.h"
+
+/**
+ * Checks that every variant of every pixel kernel (Kernels.h) produces the
+ * same output as its scalar reference, for random inputs, lengths & alignments.
+ *
+ * Variants are bound the same way as on device, once for each feature set
+ * that the host CPU can run. Output buffers have guard pixels around them,
+ * so writes past the end are caught as well.
+ */
+
+static const int Iterations = 2000;
+static const int MaxCount = 80;
+static const int MaxOffset = 4;
+static const int BufferSize = 2 * MaxCount + 2 * MaxOffset;
+static const uint32_t Guard = 0xdeadbeef;
+
+struct Variant {
+    const char *name;
+    PixelKernels kernels;
+};
+
+static Variant variants[4];
+static int variantCount;
+
+/**
+ * Binds kernels for no features (scalar or baseline SIMD), for baseline NEON,
+ * and for all features supported by host.
+ */
+static void bindVariants() {
+    CpuFeatures host;
+    detectCpuFeatures(&host);
+
+    CpuFeatures candidates[3] = {};
+    // If NEON is enabled at compile time, host has it
+    candidates[1].neon = true;
+    candidates[2] = host;
+
+    for (auto &features: candidates) {
+        auto v = &variants[variantCount];
+        v->name = bindPixelKernels(&v->kernels, features);
+
+        bool duplicate = false;
+        for (int i = 0; i < variantCount; ++i)
+            duplicate |= strcmp(variants[i].name, v->name) == 0;
+        if (!duplicate)
+            ++variantCount;
+    }
+
+    for (int i = 0; i < variantCount; ++i)
+        printf("Variant: %s\n", variants[i].name);
+}
+
+static void fillRandom(uint32_t *pixels, int count) {
+    for (int i = 0; i < count; ++i)
+        pixels[i] = testRandom();
+}
+
+static void fillRandom(uint8_t *bytes, int count) {
+    for (int i = 0; i < count; ++i)
+        bytes[i] = (uint8_t) testRandom();
+}
+
+/**
+ * Premultiplied BGRA, with fully transparent & fully opaque pixels mixed in.
+ */
+static void fillRandomCursor(uint32_t *pixels, int count) {
+    for (int i = 0; i < count; ++i) {
+        uint32_t a = testRandom() & 0xff;
+        switch (testRandom() % 4) {
+            case 0: a = 0; break;
+            case 1: a = 0xff; break;
+        }
+        uint32_t r = (testRandom() & 0xff) * a / 255;
+        uint32_t g = (testRandom() & 0xff) * a / 255;
+        uint32_t b = (testRandom() & 0xff) * a / 255;
+        pixels[i] = a << 24 | r << 16 | g << 8 | b;
+    }
+}
+
+static void resetOutput(uint32_t *expected, uint32_t *actual) {
+    for (int i = 0; i < BufferSize; ++i)
+        expected[i] = actual[i] = Guard;
+}
+
+static bool sameOutput(const Variant &v, const char *kernel, const uint32_t *expected, const uint32_t *actual,
+                       int count) {
+    for (int i = 0; i < BufferSize; ++i) {
+        if (expected[i] != actual[i]) {
+            fprintf(stderr, "%s %s: mismatch at %d (count %d): %08x vs %08x\n",
+                    v.name, kernel, i, count, expected[i], actual[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static int randomCount() { return (int) (testRandom() % (MaxCount + 1)); }
+
+static int randomOffset() { return (int) (testRandom() % MaxOffset); }
+
+static void fillRowMatchesReference() {
+    static uint32_t expected[BufferSize], actual[BufferSize];
+
+    for (int vi = 0; vi < variantCount; ++vi) {
+        auto &v = variants[vi];
+        for (int i = 0; i < Iterations; ++i) {
+            int count = randomCount(), off = randomOffset();
+            auto colour = testRandom();
+            resetOutput(expected, actual);
+
+            fillRowScalar(expected + off, colour, count);
+            v.kernels.fillRow(actual + off, colour, count);
+            if (!sameOutput(v, "fillRow", expected, actual, count)) {
+                EXPECT(false);
+                break;
+            }
+        }
+    }
+}
+
+static void yuvRowToBGRXMatchesReference() {
+    static uint32_t expected[BufferSize], actual[BufferSize];
+    static uint8_t y[BufferSize], u[BufferSize], v[BufferSize];
+
+    for (int vi = 0; vi < variantCount; ++vi) {
+        auto &var = variants[vi];
+        for (int i = 0; i < Iterations; ++i) {
+            int count = randomCount(), off = randomOffset();
+            fillRandom(y, BufferSize);
+            fillRandom(u, BufferSize);
+            fillRandom(v, BufferSize);
+
+            // Planar (I420)
+            resetOutput(expected, actual);
+            yuvRowToBGRXScalar(expected + off, y + off, u, v, 1, count);
+            var.kernels.yuvRowToBGRX(actual + off, y + off, u, v, 1, count);
+            if (!sameOutput(var, "yuvRowToBGRX (planar)", expected, actual, count)) {
+                EXPECT(false);
+                break;
+            }
+
+            // Semi-planar (NV12), interleaved chroma
+            resetOutput(expected, actual);
+            yuvRowToBGRXScalar(expected + off, y + off, u, u + 1, 2, count);
+            var.kernels.yuvRowToBGRX(actual + off, y + off, u, u + 1, 2, count);
+            if (!sameOutput(var, "yuvRowToBGRX (semi-planar)", expected, actual, count)) {
+                EXPECT(false);
+                break;
+            }
+        }
+    }
+}
+
+static void blendCursorRowMatchesReference() {
+    static uint32_t expected[BufferSize], actual[BufferSize];
+    static uint32_t fb[BufferSize], cursor[BufferSize];
+
+    for (int vi = 0; vi < variantCount; ++vi) {
+        auto &v = variants[vi];
+        for (int i = 0; i < Iterations; ++i) {
+            int count = randomCount(), off = randomOffset();
+            fillRandom(fb, BufferSize);
+            fillRandomCursor(cursor, BufferSize);
+            resetOutput(expected, actual);
+
+            blendCursorRowScalar(expected + off, fb + 1, cursor + off, count);
+            v.kernels.blendCursorRow(actual + off, fb + 1, cursor + off, count);
+            if (!sameOutput(v, "blendCursorRow", expected, actual, count)) {
+                EXPECT(false);
+                break;
+            }
+        }
+    }
+}
+
+static void averageRowsMatchesReference() {
+    static uint32_t expected[BufferSize], actual[BufferSize];
+    static uint32_t a[BufferSize], b[BufferSize];
+
+    for (int vi = 0; vi < variantCount; ++vi) {
+        auto &v = variants[vi];
+        for (int i = 0; i < Iterations; ++i) {
+            int count = randomCount(), off = randomOffset();
+            fillRandom(a, BufferSize);
+            fillRandom(b, BufferSize);
+            resetOutput(expected, actual);
+
+            averageRowsScalar(expected + off, a + 1, b + off, count);
+            v.kernels.averageRows(actual + off, a + 1, b + off, count);
+            if (!sameOutput(v, "averageRows", expected, actual, count)) {
+                EXPECT(false);
+                break;
+            }
+        }
+    }
+}
+
+static void halveRowMatchesReference() {
+    static uint32_t expected[BufferSize], actual[BufferSize];
+    static uint32_t src[BufferSize];
+
+    for (int vi = 0; vi < variantCount; ++vi) {
+        auto &v = variants[vi];
+        for (int i = 0; i < Iterations; ++i) {
+            int count = randomCount(), off = randomOffset();
+            fillRandom(src, BufferSize);
+            resetOutput(expected, actual);
+
+            halveRowScalar(expected + off, src + off, count);
+            v.kernels.halveRow(actual + off, src + off, count);
+            if (!sameOutput(v, "halveRow", expected, actual, count)) {
+                EXPECT(false);
+                break;
+            }
+        }
+    }
+}
+
+int main() {
+    bindVariants();
+
+    RUN_TEST(fillRowMatchesReference);
+    RUN_TEST(yuvRowToBGRXMatchesReference);
+    RUN_TEST(blendCursorRowMatchesReference);
+    RUN_TEST(averageRowsMatchesReference);
+    RUN_TEST(halveRowMatchesReference);
+    return testResult();
+}
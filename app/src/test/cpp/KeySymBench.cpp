@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+/**
+ * Cost of native key translation lookups (XKeySym.h), per key event.
+ */
+
+#include "Bench.h"
+#include "XKeySym.h"
+
+int main() {
+    const uint64_t n = 50 * 1000 * 1000;
+    uint64_t sink = 0;
+
+    auto keyCode = benchRun(n, [&](uint64_t i) {
+        sink += getKeySymForAndroidKeyCode((int) (i & 0xff)) + getXTKeyCodeForAndroidScanCode((int) (i & 0xff));
+    });
+
+    // Mix of Latin-1 (no lookup) & characters which need the binary search
+    auto unicode = benchRun(n, [&](uint64_t i) {
+        sink += getKeySymForUnicodeChar(0x80 + (uint32_t) (i & 0x3fff));
+    });
+
+    auto legacy = benchRun(n, [&](uint64_t i) {
+        sink += getLegacyKeySymForUnicodeChar(0x100 + (uint32_t) (i & 0x3fff));
+    });
+
+    benchSink = sink;
+    printf("Android keycode + XT code: %6.2f ns/key\n", keyCode);
+    printf("Unicode KeySym:            %6.2f ns/char\n", unicode);
+    printf("Legacy KeySym lookup:      %6.2f ns/char\n", legacy);
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#include <jni.h>
+#include "Test.h"
+#include "LazyJpeg.h"
+
+/**
+ * Uses the fake JPEG format of host turbojpeg.h: size, followed by a single colour.
+ */
+
+static const int FbSize = 16 * UploadTileSize;
+
+// Viewport in top-left corner, so that anything beyond a few tiles is deferred
+static const UploadRect Viewport = {0, 0, 2 * UploadTileSize, 2 * UploadTileSize};
+
+struct Fixture {
+    LazyJpeg lj;
+    UploadPlanner planner;
+    uint32_t *frameBuffer;
+    LazyJpegTarget fb;
+};
+
+static void setup(Fixture *f) {
+    initLazyJpeg(&f->lj);
+    initUploadPlanner(&f->planner);
+    resizeUploadPlanner(&f->planner, FbSize, FbSize);
+    f->frameBuffer = (uint32_t *) calloc((size_t) FbSize * FbSize, sizeof(uint32_t));
+    f->fb = {f->frameBuffer, FbSize, FbSize, 0, nullptr};
+    updateLazyJpegViewport(&f->lj, &f->planner, f->fb, Viewport, UINT64_MAX);
+}
+
+static void teardown(Fixture *f) {
+    free(f->frameBuffer);
+    destroyUploadPlanner(&f->planner);
+    destroyLazyJpeg(&f->lj);
+}
+
+static void receiveJpeg(Fixture *f, UploadRect r, uint32_t colour) {
+    uint8_t data[8];
+    uint16_t size[2] = {(uint16_t) r.w, (uint16_t) r.h};
+    memcpy(data, size, sizeof(size));
+    memcpy(data + 4, &colour, sizeof(colour));
+    EXPECT(handleJpegRect(&f->lj, &f->planner, f->fb, data, sizeof(data), r));
+}
+
+static uint32_t pixelAt(Fixture *f, int x, int y) {
+    return f->frameBuffer[(size_t) y * FbSize + x];
+}
+
+static void offscreenRectIsDeferred() {
+    Fixture f;
+    setup(&f);
+
+    receiveJpeg(&f, {10, 10, 16, 16}, 1);
+    receiveJpeg(&f, {12 * UploadTileSize, 12 * UploadTileSize, 16, 16}, 2);
+
+    EXPECT_EQ(1u, pixelAt(&f, 10, 10));
+    EXPECT_EQ(0u, pixelAt(&f, 12 * UploadTileSize, 12 * UploadTileSize));
+    EXPECT_EQ(1, f.lj.pendingCount);
+    teardown(&f);
+}
+
+static void viewportDecodingStopsAtDeadline() {
+    Fixture f;
+    setup(&f);
+
+    // Three rects, all off-screen
+    int x = 10 * UploadTileSize;
+    receiveJpeg(&f, {x, x, 16, 16}, 1);
+    receiveJpeg(&f, {x + 32, x, 16, 16}, 2);
+    receiveJpeg(&f, {x + 64, x, 16, 16}, 3);
+    EXPECT_EQ(3, f.lj.pendingCount);
+
+    // Deadline has already passed, but one rect is decoded to guarantee progress
+    UploadRect nearRects = {x, x, UploadTileSize, UploadTileSize};
+    EXPECT(updateLazyJpegViewport(&f.lj, &f.planner, f.fb, nearRects, 0));
+    EXPECT_EQ(2, f.lj.pendingCount);
+    EXPECT_EQ(1u, pixelAt(&f, x, x));
+
+    // With enough time, the rest are decoded
+    EXPECT(!updateLazyJpegViewport(&f.lj, &f.planner, f.fb, nearRects, UINT64_MAX));
+    EXPECT_EQ(0, f.lj.pendingCount);
+    EXPECT_EQ(3u, pixelAt(&f, x + 64, x));
+    teardown(&f);
+}
+
+static void flushDecodesEverything() {
+    Fixture f;
+    setup(&f);
+
+    receiveJpeg(&f, {8 * UploadTileSize, 8 * UploadTileSize, 16, 16}, 4);
+    receiveJpeg(&f, {14 * UploadTileSize, 3 * UploadTileSize, 16, 16}, 5);
+    EXPECT_EQ(2, f.lj.pendingCount);
+
+    flushLazyJpegs(&f.lj, &f.planner, f.fb);
+    EXPECT_EQ(0, f.lj.pendingCount);
+    EXPECT_EQ((size_t) 0, f.lj.pendingBytes);
+    EXPECT_EQ(4u, pixelAt(&f, 8 * UploadTileSize, 8 * UploadTileSize));
+    EXPECT_EQ(5u, pixelAt(&f, 14 * UploadTileSize + 15, 3 * UploadTileSize + 15));
+    teardown(&f);
+}
+
+int main() {
+    RUN_TEST(offscreenRectIsDeferred);
+    RUN_TEST(viewportDecodingStopsAtDeadline);
+    RUN_TEST(flushDecodesEverything);
+    return testResult();
+}
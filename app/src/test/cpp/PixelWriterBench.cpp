@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+/**
+ * Cost of specialised framebuffer writers (PixelWriter.h) vs LibVNCClient's
+ * generic ones, per 1080p frame worth of typical updates.
+ */
+
+#include <jni.h>
+#include "Bench.h"
+#include "Kernels.h"
+#include "ClientEx.h"
+#include "PixelWriter.h"
+#include "GenericWriters.h"
+
+static const int Width = 1920;
+static const int Height = 1080;
+static const int Tile = 64;
+
+static uint8_t bitmap[Tile * Tile * 4];
+
+typedef void (*FillRect)(rfbClient *, int, int, int, int, uint32_t);
+typedef void (*CopyBitmap)(rfbClient *, const uint8_t *, int, int, int, int);
+typedef void (*CopyRect)(rfbClient *, int, int, int, int, int, int);
+
+// Writers are called through hooks in rfbClient, so the compiler can't
+// specialise them for the constant sizes used here.
+static FillRect volatile genericFillHook = genericFillRect;
+static FillRect volatile specialisedFillHook = fillRectBGRX32;
+static CopyBitmap volatile genericBitmapHook = genericCopyBitmap;
+static CopyBitmap volatile specialisedBitmapHook = copyBitmapBGRX32;
+static CopyRect volatile genericCopyHook = genericCopyRect;
+static CopyRect volatile specialisedCopyHook = copyRectBGRX32;
+
+template<typename Generic, typename Specialised>
+static void compare(const char *name, Generic generic, Specialised specialised) {
+    double genericNs, specialisedNs;
+    benchCompare(10, 20, generic, specialised, &genericNs, &specialisedNs);
+    printf("%-24s generic: %7.3f ms, BGRX32: %7.3f ms (%.1fx)\n",
+           name, genericNs / 1e6, specialisedNs / 1e6, genericNs / specialisedNs);
+}
+
+// Solid tiles, as in ZRLE/Hextile backgrounds
+static void fillTiles(rfbClient *client, FillRect fill) {
+    for (int y = 0; y + Tile <= Height; y += Tile)
+        for (int x = 0; x + Tile <= Width; x += Tile)
+            fill(client, x, y, Tile, Tile, (uint32_t) (x * y));
+}
+
+// Small subrects, as in Hextile/RRE
+static void fillSubrects(rfbClient *client, FillRect fill) {
+    for (int y = 0; y + 4 <= Height; y += 8)
+        for (int x = 0; x + 4 <= Width; x += 8)
+            fill(client, x, y, 4, 4, (uint32_t) x);
+}
+
+// Raw tiles, as in Tight/ZRLE
+static void bitmapTiles(rfbClient *client, CopyBitmap copy) {
+    for (int y = 0; y + Tile <= Height; y += Tile)
+        for (int x = 0; x + Tile <= Width; x += Tile)
+            copy(client, bitmap, x, y, Tile, Tile);
+}
+
+int main() {
+    rfbClient client{};
+    client.width = Width;
+    client.height = Height;
+    client.format = {32, 24, 0, 1, 255, 255, 255, 16, 8, 0};
+    client.frameBuffer = (uint8_t *) calloc((size_t) Width * Height, sizeof(uint32_t));
+    auto ex = assignClientExtension(&client);
+    ex->fbRealWidth = Width;
+    ex->fbRealHeight = Height;
+    resizeUploadPlanner(&ex->uploads, Width, Height);
+    initPixelKernels();
+    memset(bitmap, 7, sizeof(bitmap));
+
+    auto c = &client;
+
+    compare("Fill 64x64 tiles", [&](uint64_t) { fillTiles(c, genericFillHook); },
+            [&](uint64_t) { fillTiles(c, specialisedFillHook); });
+
+    compare("Fill 4x4 subrects", [&](uint64_t) { fillSubrects(c, genericFillHook); },
+            [&](uint64_t) { fillSubrects(c, specialisedFillHook); });
+
+    compare("Bitmap 64x64 tiles", [&](uint64_t) { bitmapTiles(c, genericBitmapHook); },
+            [&](uint64_t) { bitmapTiles(c, specialisedBitmapHook); });
+
+    compare("CopyRect scroll up", [&](uint64_t) { genericCopyHook(c, 0, 40, Width, Height - 40, 0, 0); },
+            [&](uint64_t) { specialisedCopyHook(c, 0, 40, Width, Height - 40, 0, 0); });
+
+    compare("CopyRect scroll down", [&](uint64_t) { genericCopyHook(c, 0, 0, Width, Height - 40, 0, 40); },
+            [&](uint64_t) { specialisedCopyHook(c, 0, 0, Width, Height - 40, 0, 40); });
+
+    compare("CopyRect scroll right", [&](uint64_t) { genericCopyHook(c, 0, 0, Width - 40, Height, 40, 0); },
+            [&](uint64_t) { specialisedCopyHook(c, 0, 0, Width - 40, Height, 40, 0); });
+
+    benchSink = ((uint32_t *) client.frameBuffer)[0];
+    free(client.frameBuffer);
+    freeClientExtension(&client);
+    return 0;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#include <jni.h>
+#include "Test.h"
+#include "Kernels.h"
+#include "ClientEx.h"
+#include "PixelWriter.h"
+#include "GenericWriters.h"
+
+/**
+ * Checks specialised writers (PixelWriter.h) against LibVNCClient's generic
+ * ones, by applying the same random updates to two framebuffers.
+ */
+
+static const int Width = 640;
+static const int Height = 480;
+static const int Operations = 3000;
+static const int MaxRectSize = 200;
+
+static uint32_t bitmap[Width * MaxRectSize];
+
+static void setupClient(rfbClient *client) {
+    memset(client, 0, sizeof(*client));
+    client->width = Width;
+    client->height = Height;
+    client->format = {32, 24, 0, 1, 255, 255, 255, 16, 8, 0};
+    client->frameBuffer = (uint8_t *) malloc((size_t) Width * Height * sizeof(uint32_t));
+
+    auto ex = assignClientExtension(client);
+    ex->fbRealWidth = Width;
+    ex->fbRealHeight = Height;
+    resizeUploadPlanner(&ex->uploads, Width, Height);
+}
+
+static void teardownClient(rfbClient *client) {
+    free(client->frameBuffer);
+    freeClientExtension(client);
+}
+
+static bool sameFrameBuffers(rfbClient *a, rfbClient *b) {
+    return memcmp(a->frameBuffer, b->frameBuffer, (size_t) Width * Height * sizeof(uint32_t)) == 0;
+}
+
+static void randomRect(int *x, int *y, int *w, int *h) {
+    *w = 1 + (int) (testRandom() % MaxRectSize);
+    *h = 1 + (int) (testRandom() % MaxRectSize);
+    *x = (int) (testRandom() % (Width - *w + 1));
+    *y = (int) (testRandom() % (Height - *h + 1));
+}
+
+static void installedForBGRX32Only() {
+    rfbClient client;
+    setupClient(&client);
+
+    installPixelWriters(&client);
+    EXPECT(client.GotFillRect == fillRectBGRX32);
+    EXPECT(client.GotCopyRect == copyRectBGRX32);
+
+    rfbClient other;
+    memset(&other, 0, sizeof(other));
+    other.format = {16, 16, 0, 1, 31, 63, 31, 11, 5, 0};
+    installPixelWriters(&other);
+    EXPECT(other.GotFillRect == nullptr);
+
+    teardownClient(&client);
+}
+
+static void writersMatchGenericOnes() {
+    rfbClient generic, specialised;
+    setupClient(&generic);
+    setupClient(&specialised);
+
+    for (int i = 0; i < Width * Height; ++i)
+        ((uint32_t *) generic.frameBuffer)[i] = testRandom();
+    memcpy(specialised.frameBuffer, generic.frameBuffer, (size_t) Width * Height * sizeof(uint32_t));
+
+    int x, y, w, h, op;
+    for (op = 0; op < Operations; ++op) {
+        randomRect(&x, &y, &w, &h);
+
+        switch (testRandom() % 4) {
+            case 0: {
+                auto colour = testRandom();
+                genericFillRect(&generic, x, y, w, h, colour);
+                fillRectBGRX32(&specialised, x, y, w, h, colour);
+                break;
+            }
+            case 1: {
+                for (int i = 0; i < w * h; ++i)
+                    bitmap[i] = testRandom();
+                genericCopyBitmap(&generic, (uint8_t *) bitmap, x, y, w, h);
+                copyBitmapBGRX32(&specialised, (uint8_t *) bitmap, x, y, w, h);
+                break;
+            }
+            case 2: {
+                // Full-width rows are copied in one go
+                for (int i = 0; i < Width * h; ++i)
+                    bitmap[i] = testRandom();
+                genericCopyBitmap(&generic, (uint8_t *) bitmap, 0, y, Width, h);
+                copyBitmapBGRX32(&specialised, (uint8_t *) bitmap, 0, y, Width, h);
+                break;
+            }
+            case 3: {
+                // Mostly overlapping, as in scrolling
+                int dx = (int) (testRandom() % 41) - 20, dy = (int) (testRandom() % 41) - 20;
+                int dstX = x + dx, dstY = y + dy;
+                if (dstX < 0 || dstY < 0 || dstX + w > Width || dstY + h > Height)
+                    break;
+                genericCopyRect(&generic, x, y, w, h, dstX, dstY);
+                copyRectBGRX32(&specialised, x, y, w, h, dstX, dstY);
+                break;
+            }
+        }
+
+        if (!sameFrameBuffers(&generic, &specialised))
+            break;
+    }
+    EXPECT_EQ(Operations, op);
+
+    teardownClient(&generic);
+    teardownClient(&specialised);
+}
+
+static void invalidRectsAreIgnored() {
+    rfbClient client;
+    setupClient(&client);
+    memset(client.frameBuffer, 0, (size_t) Width * Height * sizeof(uint32_t));
+
+    fillRectBGRX32(&client, Width - 10, 0, 20, 10, 1);
+    fillRectBGRX32(&client, -1, 0, 10, 10, 1);
+    fillRectBGRX32(&client, 0, 0, 0, 10, 1);
+    copyBitmapBGRX32(&client, (uint8_t *) bitmap, 0, Height - 5, 10, 10);
+    copyRectBGRX32(&client, 0, 0, 10, 10, Width - 5, 0);
+
+    for (int i = 0; i < Width * Height; ++i) {
+        if (((uint32_t *) client.frameBuffer)[i]) {
+            EXPECT(false);
+            break;
+        }
+    }
+    teardownClient(&client);
+}
+
+int main() {
+    initPixelKernels();
+
+    RUN_TEST(installedForBGRX32Only);
+    RUN_TEST(writersMatchGenericOnes);
+    RUN_TEST(invalidRectsAreIgnored);
+    return testResult();
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_TEST_TEST_H
+#define AVNC_TEST_TEST_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * Minimal helpers for host tests.
+ *
+ * Each test program calls its test functions from main() using RUN_TEST, and
+ * returns testResult(). Failed expectations are reported, but don't stop the test.
+ */
+
+static int testFailures = 0;
+
+#define EXPECT(cond) \
+    do { if (!(cond)) { ++testFailures; fprintf(stderr, "%s:%d: Expected: %s\n", __FILE__, __LINE__, #cond); } } while (0)
+
+#define EXPECT_EQ(expected, actual) \
+    do { \
+        auto e_ = (expected); auto a_ = (actual); \
+        if (!(e_ == a_)) { \
+            ++testFailures; \
+            fprintf(stderr, "%s:%d: Expected %s == %s (%lld vs %lld)\n", __FILE__, __LINE__, #expected, #actual, \
+                    (long long) e_, (long long) a_); \
+        } \
+    } while (0)
+
+#define RUN_TEST(fn) \
+    do { int before_ = testFailures; fn(); printf("%s %s\n", testFailures == before_ ? "[ OK ]" : "[FAIL]", #fn); } while (0)
+
+/**
+ * Deterministic pseudo-random numbers (xorshift32), so that failures can be reproduced.
+ */
+static uint32_t testRandomState = 2463534242u;
+
+static uint32_t testRandom() {
+    auto x = testRandomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return testRandomState = x;
+}
+
+static int testResult() {
+    return testFailures == 0 ? 0 : 1;
+}
+
+#endif //AVNC_TEST_TEST_H
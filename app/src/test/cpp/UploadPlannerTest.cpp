@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#include <jni.h>
+#include "Test.h"
+#include "UploadPlanner.h"
+
+// 8x8 tiles
+static const int FbSize = 8 * UploadTileSize;
+
+// Viewport covers the top-left 2x2 tiles, cursor is in the bottom-right tile
+static const UploadHints Hints = {{0, 0, 2 * UploadTileSize, 2 * UploadTileSize}, FbSize - 10, FbSize - 10};
+
+/**
+ * Prepares a planner where every tile has been uploaded.
+ */
+static void initCleanPlanner(UploadPlanner *planner) {
+    initUploadPlanner(planner);
+    resizeUploadPlanner(planner, FbSize, FbSize);
+    planner->needsAllocation = false;
+
+    UploadRect rect;
+    int count = planUploads(planner, &Hints);
+    for (int i = 0; i < count; ++i)
+        takePlannedTile(planner, i, &rect);
+}
+
+/**
+ * Marks damage for the tile at given column & row, making sure its damage
+ * time is later than that of previously marked tiles.
+ */
+static void damageTile(UploadPlanner *planner, int col, int row) {
+    auto start = monotonicTimeUs();
+    while (monotonicTimeUs() == start);
+    markDamage(planner, col * UploadTileSize + 1, row * UploadTileSize + 1, 1, 1);
+}
+
+static UploadRect takeTile(UploadPlanner *planner, int position) {
+    UploadRect rect = {-1, -1, 0, 0};
+    EXPECT(takePlannedTile(planner, position, &rect));
+    return rect;
+}
+
+static void cleanPlannerHasNoUploads() {
+    UploadPlanner planner;
+    initCleanPlanner(&planner);
+
+    EXPECT(!hasPendingUploads(&planner));
+    EXPECT_EQ(0, planUploads(&planner, &Hints));
+    destroyUploadPlanner(&planner);
+}
+
+static void visibleThenCursorThenOldest() {
+    UploadPlanner planner;
+    initCleanPlanner(&planner);
+
+    damageTile(&planner, 4, 4); // Oldest, hidden
+    damageTile(&planner, 7, 7); // Under cursor
+    damageTile(&planner, 5, 0); // Hidden, newer
+    damageTile(&planner, 1, 1); // Visible, newest
+
+    EXPECT_EQ(4, planUploads(&planner, &Hints));
+
+    auto first = takeTile(&planner, 0);
+    auto second = takeTile(&planner, 1);
+    auto third = takeTile(&planner, 2);
+    auto fourth = takeTile(&planner, 3);
+
+    EXPECT_EQ(1 * UploadTileSize, first.x);
+    EXPECT_EQ(1 * UploadTileSize, first.y);
+    EXPECT_EQ(7 * UploadTileSize, second.x);
+    EXPECT_EQ(7 * UploadTileSize, second.y);
+    EXPECT_EQ(4 * UploadTileSize, third.x);
+    EXPECT_EQ(4 * UploadTileSize, third.y);
+    EXPECT_EQ(5 * UploadTileSize, fourth.x);
+    EXPECT_EQ(0, fourth.y);
+
+    EXPECT(!hasPendingUploads(&planner));
+    destroyUploadPlanner(&planner);
+}
+
+static void oldestFirstWithinClass() {
+    UploadPlanner planner;
+    initCleanPlanner(&planner);
+
+    damageTile(&planner, 1, 0);
+    damageTile(&planner, 0, 0);
+    damageTile(&planner, 0, 1);
+
+    EXPECT_EQ(3, planUploads(&planner, &Hints));
+    EXPECT_EQ(1 * UploadTileSize, takeTile(&planner, 0).x);
+    EXPECT_EQ(0, takeTile(&planner, 1).y);
+    EXPECT_EQ(1 * UploadTileSize, takeTile(&planner, 2).y);
+    destroyUploadPlanner(&planner);
+}
+
+static void remainingTilesCarryOver() {
+    UploadPlanner planner;
+    initCleanPlanner(&planner);
+
+    damageTile(&planner, 0, 0);
+    damageTile(&planner, 3, 3);
+    damageTile(&planner, 6, 6);
+
+    // Budget runs out after first tile
+    EXPECT_EQ(3, planUploads(&planner, &Hints));
+    auto uploaded = takeTile(&planner, 0);
+    finishUploadFrame(&planner, 1, 2);
+
+    EXPECT(hasPendingUploads(&planner));
+    EXPECT_EQ(1, (int) planner.carriedOverFrames);
+    EXPECT_EQ(2, planner.maxCarriedOverTiles);
+
+    // Next frame gets the rest, in the same order
+    EXPECT_EQ(2, planUploads(&planner, &Hints));
+    auto second = takeTile(&planner, 0);
+    auto third = takeTile(&planner, 1);
+    finishUploadFrame(&planner, 2, 0);
+
+    EXPECT_EQ(0, uploaded.x);
+    EXPECT_EQ(3 * UploadTileSize, second.x);
+    EXPECT_EQ(6 * UploadTileSize, third.x);
+    EXPECT(!hasPendingUploads(&planner));
+    EXPECT_EQ(1, (int) planner.carriedOverFrames);
+    destroyUploadPlanner(&planner);
+}
+
+static void damageDuringUploadIsKept() {
+    UploadPlanner planner;
+    initCleanPlanner(&planner);
+
+    damageTile(&planner, 2, 2);
+    EXPECT_EQ(1, planUploads(&planner, &Hints));
+    takeTile(&planner, 0);
+
+    // Decoder writes to the tile while renderer is still uploading it
+    damageTile(&planner, 2, 2);
+    finishUploadFrame(&planner, 1, 0);
+
+    EXPECT(hasPendingUploads(&planner));
+    EXPECT_EQ(1, planUploads(&planner, &Hints));
+    EXPECT_EQ(2 * UploadTileSize, takeTile(&planner, 0).x);
+    EXPECT(!hasPendingUploads(&planner));
+    destroyUploadPlanner(&planner);
+}
+
+static void damageAfterPlanningIsTakenOnce() {
+    UploadPlanner planner;
+    initCleanPlanner(&planner);
+
+    damageTile(&planner, 3, 0);
+    EXPECT_EQ(1, planUploads(&planner, &Hints));
+
+    // Already dirty, so this doesn't add a second entry
+    damageTile(&planner, 3, 0);
+    takeTile(&planner, 0);
+
+    EXPECT(!hasPendingUploads(&planner));
+    EXPECT_EQ(0, planUploads(&planner, &Hints));
+    destroyUploadPlanner(&planner);
+}
+
+static void edgeTilesAreClipped() {
+    UploadPlanner planner;
+    initUploadPlanner(&planner);
+    resizeUploadPlanner(&planner, UploadTileSize + 10, UploadTileSize + 20);
+
+    UploadHints hints = {{0, 0, UploadTileSize + 10, UploadTileSize + 20}, 0, 0};
+    EXPECT_EQ(4, planUploads(&planner, &hints));
+
+    int area = 0;
+    UploadRect rect;
+    for (int i = 0; i < 4; ++i) {
+        if (takePlannedTile(&planner, i, &rect))
+            area += rect.w * rect.h;
+    }
+    EXPECT_EQ((UploadTileSize + 10) * (UploadTileSize + 20), area);
+    destroyUploadPlanner(&planner);
+}
+
+static void adjacentTilesShareStage() {
+    UploadRect tiles[] = {
+            {2 * UploadTileSize, 0, UploadTileSize, UploadTileSize},
+            {0, 0, UploadTileSize, UploadTileSize},
+            {UploadTileSize, 0, UploadTileSize, UploadTileSize},
+            {0, UploadTileSize, UploadTileSize, UploadTileSize},
+    };
+    UploadStage stages[4];
+    size_t bytes = 0;
+
+    EXPECT_EQ(2, planStages(tiles, 4, stages, &bytes));
+    EXPECT_EQ(3 * UploadTileSize, stages[0].region.w);
+    EXPECT(stages[0].contiguous);
+    EXPECT_EQ(3, stages[0].tileCount);
+    EXPECT_EQ(1, stages[1].tileCount);
+    EXPECT_EQ((size_t) 4 * UploadTileSize * UploadTileSize * 4, bytes);
+}
+
+int main() {
+    RUN_TEST(cleanPlannerHasNoUploads);
+    RUN_TEST(visibleThenCursorThenOldest);
+    RUN_TEST(oldestFirstWithinClass);
+    RUN_TEST(remainingTilesCarryOver);
+    RUN_TEST(damageDuringUploadIsKept);
+    RUN_TEST(damageAfterPlanningIsTakenOnce);
+    RUN_TEST(edgeTilesAreClipped);
+    RUN_TEST(adjacentTilesShareStage);
+    return testResult();
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#include <jni.h>
+#include <stdio.h>
+#include "Test.h"
+#include "Kernels.h"
+#include "ClientEx.h"
+#include "PixelWriter.h"
+#include "H264Decoder.h"
+
+/**
+ * Checks that update hot path doesn't allocate once buffers have grown to fit
+ * the workload: a random sequence of updates is run once to warm up, then
+ * replayed while counting allocations.
+ *
+ * Allocations are counted by interposing malloc & friends, which relies on
+ * glibc exporting its own allocator as __libc_malloc etc.
+ */
+
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+extern "C" void __libc_free(void *ptr);
+
+static const int MaxRecordedAllocations = 16;
+
+static bool counting;
+static int allocations;
+static void *callers[MaxRecordedAllocations];
+static size_t sizes[MaxRecordedAllocations];
+
+static void recordAllocation(void *caller, size_t size) {
+    if (!__atomic_load_n(&counting, __ATOMIC_RELAXED))
+        return;
+    auto i = __atomic_fetch_add(&allocations, 1, __ATOMIC_RELAXED);
+    if (i < MaxRecordedAllocations) {
+        callers[i] = caller;
+        sizes[i] = size;
+    }
+}
+
+extern "C" void *malloc(size_t size) {
+    recordAllocation(__builtin_return_address(0), size);
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size) {
+    recordAllocation(__builtin_return_address(0), count * size);
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size) {
+    recordAllocation(__builtin_return_address(0), size);
+    return __libc_realloc(ptr, size);
+}
+
+extern "C" void free(void *ptr) {
+    __libc_free(ptr);
+}
+
+// Desktop size
+static const int Width = 3840;
+static const int Height = 2160;
+
+static const int Operations = 5000;
+static const int MaxRectSize = 256;
+
+static uint8_t bitmap[MaxRectSize * MaxRectSize * 4];
+static uint8_t cursorMask[CursorPreallocSize * CursorPreallocSize];
+static uint8_t jpeg[4096];
+
+/**
+ * Prepares client in the same way as onMallocFrameBuffer().
+ */
+static void setupClient(rfbClient *client, int shift) {
+    memset(client, 0, sizeof(*client));
+    auto ex = assignClientExtension(client);
+    ex->cursor = newCursor();
+
+    client->width = Width;
+    client->height = Height;
+    ex->fbShift = shift;
+    ex->fbRealWidth = scaledLength(Width, shift);
+    ex->fbRealHeight = scaledLength(Height, shift);
+    client->frameBuffer = (uint8_t *) calloc((size_t) ex->fbRealWidth * ex->fbRealHeight, 4);
+    resizeUploadPlanner(&ex->uploads, ex->fbRealWidth, ex->fbRealHeight);
+
+    reserveScratch(&ex->cursorShape, CursorPreallocSize * CursorPreallocSize);
+    if (shift) {
+        reserveScratch(&ex->cursorScaled, CursorPreallocSize * CursorPreallocSize);
+        reserveScratch(&ex->fbScratch, (size_t) Width + 2);
+
+        // Zoomed in on the middle, so that writes also go to full resolution region
+        UploadRect missing[4];
+        LOCK(ex->mutex);
+        setFrameDetailRegionLocked(&ex->detail, {Width / 4, Height / 4, Width / 2, Height / 2},
+                                   (uint32_t *) client->frameBuffer, ex->fbRealWidth, shift, missing);
+        UNLOCK(ex->mutex);
+    }
+
+    newH264Decoder(client);
+}
+
+static void teardownClient(rfbClient *client) {
+    auto ex = getClientExtension(client);
+    freeH264Decoder(ex->h264);
+    free(client->frameBuffer);
+    freeClientExtension(client);
+}
+
+/**
+ * Same as setCursorShape() in native-vnc.cpp.
+ */
+static void setCursorShape(ClientEx *ex, uint16_t width, uint16_t height) {
+    auto shape = &ex->cursorShape;
+    auto fullWidth = width, fullHeight = height;
+    auto shift = ex->fbShift;
+    if (shift) {
+        auto w = (uint16_t) scaledLength(width, shift);
+        auto h = (uint16_t) scaledLength(height, shift);
+        auto scaled = reserveScratch(&ex->cursorScaled, (size_t) w * h);
+        if (scaled && downsampleBlock(scaled, w, shape->data, width, 0, 0, width, height, shift, &ex->fbScratch)) {
+            shape = &ex->cursorScaled;
+            width = w;
+            height = h;
+        }
+    }
+
+    LOCK(ex->mutex);
+    updateCursor(ex->cursor, shape, width, height, 0, 0);
+    if (shape != &ex->cursorShape)
+        updateFrameDetailCursor(&ex->detail, &ex->cursorShape, fullWidth, fullHeight, 0, 0);
+    UNLOCK(ex->mutex);
+}
+
+static void runWorkload(rfbClient *client, unsigned seed) {
+    auto ex = getClientExtension(client);
+    srand(seed);
+
+    for (int op = 0; op < Operations; ++op) {
+        int w = 1 + rand() % MaxRectSize, h = 1 + rand() % MaxRectSize;
+        int x = rand() % (Width - w), y = rand() % (Height - h);
+
+        switch (rand() % 7) {
+            case 0:
+                copyBitmapBGRX32(client, bitmap, x, y, w, h);
+                break;
+
+            case 1:
+                fillRectBGRX32(client, x, y, w, h, (uint32_t) rand());
+                break;
+
+            case 2:
+                copyRectBGRX32(client, x, y, w, h, rand() % (Width - w), rand() % (Height - h));
+                break;
+
+            case 3: {
+                uint16_t size[2] = {(uint16_t) w, (uint16_t) h};
+                memcpy(jpeg, size, sizeof(size));
+                decodeJpegBGRX32(client, jpeg, 100 + rand() % 3000, x, y, w, h);
+                break;
+            }
+
+            case 4: {
+                UploadRect viewport = {rand() % 1000, rand() % 1000, 300, 300};
+                LOCK(ex->mutex);
+                updateLazyJpegViewport(&ex->jpeg, &ex->uploads, getWriteTarget(client), viewport, UINT64_MAX);
+                UNLOCK(ex->mutex);
+                break;
+            }
+
+            case 5: {
+                int cw = 8 + rand() % (CursorPreallocSize - 7), ch = 8 + rand() % (CursorPreallocSize - 7);
+                auto pixels = reserveScratch(&ex->cursorShape, (size_t) cw * ch);
+                cursorPixelsFromMask(pixels, bitmap, cursorMask, (size_t) cw * ch);
+                setCursorShape(ex, (uint16_t) cw, (uint16_t) ch);
+                break;
+            }
+
+            case 6: {
+                // Frames in flight, as between receiver & decoder thread
+                auto decoder = ex->h264;
+                H264Frame *frames[3];
+                for (auto &frame: frames)
+                    frame = acquireH264Frame(decoder, 1000 + rand() % 200000);
+                LOCK(decoder->mutex);
+                for (auto &frame: frames)
+                    recycleH264Frame(decoder, frame);
+                UNLOCK(decoder->mutex);
+                break;
+            }
+        }
+    }
+}
+
+static void expectNoAllocationsOnReplay(int shift) {
+    rfbClient client;
+    setupClient(&client, shift);
+
+    runWorkload(&client, 42);
+
+    allocations = 0;
+    __atomic_store_n(&counting, true, __ATOMIC_RELAXED);
+    runWorkload(&client, 42);
+    __atomic_store_n(&counting, false, __ATOMIC_RELAXED);
+
+    EXPECT_EQ(0, allocations);
+    for (int i = 0; i < allocations && i < MaxRecordedAllocations; ++i)
+        fprintf(stderr, "  %zu bytes allocated from %p\n", sizes[i], callers[i]);
+
+    teardownClient(&client);
+}
+
+static void fullResolutionFrameBuffer() {
+    expectNoAllocationsOnReplay(0);
+}
+
+static void downsampledFrameBuffer() {
+    expectNoAllocationsOnReplay(1);
+}
+
+int main() {
+    initPixelKernels();
+
+    RUN_TEST(fullResolutionFrameBuffer);
+    RUN_TEST(downsampledFrameBuffer);
+    return testResult();
+}
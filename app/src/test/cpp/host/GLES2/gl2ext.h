@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_TEST_HOST_GLES2_EXT_H
+#define AVNC_TEST_HOST_GLES2_EXT_H
+
+/**
+ * Host stand-in for <GLES2/gl2ext.h>.
+ */
+
+#define GL_BGRA_EXT 0x80E1
+
+#endif //AVNC_TEST_HOST_GLES2_EXT_H
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_TEST_HOST_GLES3_H
+#define AVNC_TEST_HOST_GLES3_H
+
+/**
+ * Host stand-in for <GLES3/gl3.h>. There is no GL context on host, so calls
+ * do nothing, and buffer mapping always fails.
+ */
+
+#include <stdint.h>
+
+typedef unsigned int GLenum;
+typedef unsigned int GLuint;
+typedef unsigned int GLbitfield;
+typedef unsigned char GLboolean;
+typedef int GLint;
+typedef int GLsizei;
+typedef intptr_t GLintptr;
+typedef intptr_t GLsizeiptr;
+
+#define GL_TEXTURE_2D 0x0DE1
+#define GL_UNSIGNED_BYTE 0x1401
+#define GL_RGBA 0x1908
+#define GL_UNPACK_ROW_LENGTH 0x0CF2
+#define GL_STREAM_DRAW 0x88E0
+#define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#define GL_MAP_WRITE_BIT 0x0002
+#define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+
+static inline void glTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void *) {}
+static inline void glTexSubImage2D(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const void *) {}
+static inline void glPixelStorei(GLenum, GLint) {}
+static inline void glGenBuffers(GLsizei, GLuint *buffers) { *buffers = 0; }
+static inline void glBindBuffer(GLenum, GLuint) {}
+static inline void glBufferData(GLenum, GLsizeiptr, const void *, GLenum) {}
+static inline void *glMapBufferRange(GLenum, GLintptr, GLsizeiptr, GLbitfield) { return nullptr; }
+static inline GLboolean glUnmapBuffer(GLenum) { return 0; }
+
+#endif //AVNC_TEST_HOST_GLES3_H
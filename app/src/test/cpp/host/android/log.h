@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_TEST_HOST_ANDROID_LOG_H
+#define AVNC_TEST_HOST_ANDROID_LOG_H
+
+/**
+ * Host stand-in for <android/log.h>. Logs go to stderr.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+
+enum {
+    ANDROID_LOG_INFO = 4,
+    ANDROID_LOG_ERROR = 6,
+};
+
+static inline int __android_log_vprint(int, const char *tag, const char *fmt, va_list args) {
+    fprintf(stderr, "%s: ", tag);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    return 0;
+}
+
+#endif //AVNC_TEST_HOST_ANDROID_LOG_H
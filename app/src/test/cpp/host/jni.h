@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_TEST_HOST_JNI_H
+#define AVNC_TEST_HOST_JNI_H
+
+/**
+ * Minimal stand-in for <jni.h>, so that native headers can be compiled on host.
+ * Only the parts referenced by headers under test are provided. Tests never
+ * call into Java, so methods are trivial.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+typedef int32_t jint;
+typedef int64_t jlong;
+typedef uint8_t jboolean;
+typedef int8_t jbyte;
+typedef jint jsize;
+
+class _jobject {};
+class _jclass : public _jobject {};
+class _jstring : public _jobject {};
+
+typedef _jobject *jobject;
+typedef _jclass *jclass;
+typedef _jstring *jstring;
+
+struct _jmethodID;
+typedef _jmethodID *jmethodID;
+
+#define JNI_FALSE 0
+#define JNI_TRUE 1
+#define JNIEXPORT __attribute__ ((visibility ("default")))
+#define JNICALL
+
+struct _JNIEnv {
+    const char *GetStringUTFChars(jstring, jboolean *) { return ""; }
+    void ReleaseStringUTFChars(jstring, const char *) {}
+};
+typedef _JNIEnv JNIEnv;
+
+#endif //AVNC_TEST_HOST_JNI_H
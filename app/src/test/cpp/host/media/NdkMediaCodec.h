@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_TEST_HOST_NDK_MEDIA_CODEC_H
+#define AVNC_TEST_HOST_NDK_MEDIA_CODEC_H
+
+/**
+ * Host stand-in for <media/NdkMediaCodec.h>. There are no codecs on host,
+ * so creation always fails.
+ */
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <media/NdkMediaFormat.h>
+
+typedef struct AMediaCodec AMediaCodec;
+
+typedef struct {
+    int32_t offset;
+    int32_t size;
+    int64_t presentationTimeUs;
+    uint32_t flags;
+} AMediaCodecBufferInfo;
+
+enum {
+    AMEDIACODEC_INFO_OUTPUT_BUFFERS_CHANGED = -3,
+    AMEDIACODEC_INFO_OUTPUT_FORMAT_CHANGED = -2,
+    AMEDIACODEC_INFO_TRY_AGAIN_LATER = -1,
+};
+
+static inline AMediaCodec *AMediaCodec_createCodecByName(const char *) { return nullptr; }
+static inline AMediaCodec *AMediaCodec_createDecoderByType(const char *) { return nullptr; }
+
+static inline media_status_t AMediaCodec_configure(AMediaCodec *, const AMediaFormat *, void *, void *, uint32_t) {
+    return AMEDIA_ERROR_UNSUPPORTED;
+}
+
+static inline media_status_t AMediaCodec_start(AMediaCodec *) { return AMEDIA_ERROR_UNSUPPORTED; }
+static inline media_status_t AMediaCodec_stop(AMediaCodec *) { return AMEDIA_OK; }
+static inline media_status_t AMediaCodec_delete(AMediaCodec *) { return AMEDIA_OK; }
+static inline AMediaFormat *AMediaCodec_getOutputFormat(AMediaCodec *) { return nullptr; }
+
+static inline ssize_t AMediaCodec_dequeueInputBuffer(AMediaCodec *, int64_t) { return AMEDIACODEC_INFO_TRY_AGAIN_LATER; }
+static inline uint8_t *AMediaCodec_getInputBuffer(AMediaCodec *, size_t, size_t *) { return nullptr; }
+
+static inline media_status_t AMediaCodec_queueInputBuffer(AMediaCodec *, size_t, off_t, size_t, uint64_t, uint32_t) {
+    return AMEDIA_ERROR_UNSUPPORTED;
+}
+
+static inline ssize_t AMediaCodec_dequeueOutputBuffer(AMediaCodec *, AMediaCodecBufferInfo *, int64_t) {
+    return AMEDIACODEC_INFO_TRY_AGAIN_LATER;
+}
+
+static inline uint8_t *AMediaCodec_getOutputBuffer(AMediaCodec *, size_t, size_t *) { return nullptr; }
+static inline media_status_t AMediaCodec_releaseOutputBuffer(AMediaCodec *, size_t, bool) { return AMEDIA_OK; }
+
+#endif //AVNC_TEST_HOST_NDK_MEDIA_CODEC_H
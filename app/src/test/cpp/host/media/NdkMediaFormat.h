@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_TEST_HOST_NDK_MEDIA_FORMAT_H
+#define AVNC_TEST_HOST_NDK_MEDIA_FORMAT_H
+
+/**
+ * Host stand-in for <media/NdkMediaFormat.h>. Formats are never created.
+ */
+
+#include <stdint.h>
+
+typedef int32_t media_status_t;
+#define AMEDIA_OK 0
+#define AMEDIA_ERROR_UNSUPPORTED (-10000)
+
+typedef struct AMediaFormat AMediaFormat;
+
+static const char *AMEDIAFORMAT_KEY_MIME = "mime";
+static const char *AMEDIAFORMAT_KEY_WIDTH = "width";
+static const char *AMEDIAFORMAT_KEY_HEIGHT = "height";
+static const char *AMEDIAFORMAT_KEY_COLOR_FORMAT = "color-format";
+static const char *AMEDIAFORMAT_KEY_STRIDE = "stride";
+
+static inline AMediaFormat *AMediaFormat_new() { return nullptr; }
+static inline media_status_t AMediaFormat_delete(AMediaFormat *) { return AMEDIA_OK; }
+static inline void AMediaFormat_setString(AMediaFormat *, const char *, const char *) {}
+static inline void AMediaFormat_setInt32(AMediaFormat *, const char *, int32_t) {}
+static inline bool AMediaFormat_getInt32(AMediaFormat *, const char *, int32_t *) { return false; }
+
+#endif //AVNC_TEST_HOST_NDK_MEDIA_FORMAT_H
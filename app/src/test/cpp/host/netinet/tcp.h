@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_TEST_HOST_NETINET_TCP_H
+#define AVNC_TEST_HOST_NETINET_TCP_H
+
+/**
+ * Host stand-in for Bionic's <netinet/tcp.h>, whose tcp_info comes from the
+ * kernel headers. Glibc has its own, older definition.
+ */
+
+#include <sys/socket.h>
+#include <linux/tcp.h>
+
+#endif //AVNC_TEST_HOST_NETINET_TCP_H
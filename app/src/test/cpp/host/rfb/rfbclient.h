@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_TEST_HOST_RFBCLIENT_H
+#define AVNC_TEST_HOST_RFBCLIENT_H
+
+/**
+ * Minimal stand-in for LibVNCClient's <rfb/rfbclient.h>, so that native headers
+ * can be compiled on host. Declarations match LibVNCClient, but only the parts
+ * referenced by native headers are provided. Tests never talk to a server, so
+ * protocol functions are trivial.
+ */
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <zlib.h>
+
+typedef int8_t rfbBool;
+#define TRUE 1
+#define FALSE 0
+
+#define MUTEX(mutex) pthread_mutex_t (mutex)
+#define INIT_MUTEX(mutex) pthread_mutex_init(&(mutex), NULL)
+#define TINI_MUTEX(mutex) pthread_mutex_destroy(&(mutex))
+#define LOCK(mutex) pthread_mutex_lock(&(mutex))
+#define UNLOCK(mutex) pthread_mutex_unlock(&(mutex))
+
+#define THREAD_ROUTINE_RETURN_TYPE void*
+#define THREAD_ROUTINE_RETURN_VALUE NULL
+
+#define rfbFramebufferUpdateRequest 3
+#define rfbPointerEvent 5
+#define sz_rfbPointerEventMsg 6
+
+#define rfbClientSwap16IfLE(s) __builtin_bswap16(s)
+#define rfbClientSwap32IfLE(l) __builtin_bswap32(l)
+
+typedef struct {
+    uint8_t bitsPerPixel, depth, bigEndian, trueColour;
+    uint16_t redMax, greenMax, blueMax;
+    uint8_t redShift, greenShift, blueShift;
+} rfbPixelFormat;
+
+typedef struct {
+    uint16_t x, y, w, h;
+} rfbRectangle;
+
+typedef struct {
+    rfbRectangle r;
+    uint32_t encoding;
+} rfbFramebufferUpdateRectHeader;
+
+typedef struct _rfbClient rfbClient;
+
+typedef void (*GotFillRectProc)(rfbClient *, int, int, int, int, uint32_t);
+typedef void (*GotBitmapProc)(rfbClient *, const uint8_t *, int, int, int, int);
+typedef void (*GotCopyRectProc)(rfbClient *, int, int, int, int, int, int);
+typedef rfbBool (*GotJpegProc)(rfbClient *, const uint8_t *, int, int, int, int, int);
+typedef void (*GotXCutTextProc)(rfbClient *, const char *, int);
+
+typedef struct _rfbClient {
+    uint8_t *frameBuffer;
+    int width, height;
+    rfbPixelFormat format;
+
+    int sock;
+    void *tlsSession;
+    char buf[8192];
+    char *bufoutptr;
+    unsigned int buffered;
+
+    z_stream decompStream;
+    rfbBool decompStreamInited;
+    z_stream zlibStream[4];
+    rfbBool zlibStreamActive[4];
+    char *raw_buffer;
+    int raw_buffer_size;
+    char *ultra_buffer;
+    int ultra_buffer_size;
+
+    int extendedClipboardServerCapabilities;
+
+    GotFillRectProc GotFillRect;
+    GotBitmapProc GotBitmap;
+    GotCopyRectProc GotCopyRect;
+    GotJpegProc GotJpeg;
+    GotXCutTextProc GotXCutText;
+    GotXCutTextProc GotXCutTextUTF8;
+
+    // Host only: LibVNCClient keeps a list of client data, tests need just one.
+    void *clientData;
+} rfbClient;
+
+typedef void (*rfbClientLogProc)(const char *format, ...);
+
+static void hostClientLog(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+}
+
+static rfbClientLogProc rfbClientLog = hostClientLog;
+static rfbClientLogProc rfbClientErr = hostClientLog;
+
+static inline void *rfbClientGetClientData(rfbClient *client, void *) { return client->clientData; }
+static inline void rfbClientSetClientData(rfbClient *client, void *, void *data) { client->clientData = data; }
+
+// Reads fail, writes are dropped
+static inline rfbBool ReadFromRFBServer(rfbClient *, char *, unsigned int) { return FALSE; }
+static inline rfbBool WriteToRFBServer(rfbClient *, const char *, unsigned int) { return TRUE; }
+static inline int WaitForMessage(rfbClient *, unsigned int) { return 0; }
+static inline rfbBool SendFramebufferUpdateRequest(rfbClient *, int, int, int, int, rfbBool) { return TRUE; }
+static inline rfbBool SendIncrementalFramebufferUpdateRequest(rfbClient *) { return TRUE; }
+static inline rfbBool SendExtDesktopSize(rfbClient *, uint16_t, uint16_t) { return TRUE; }
+
+#endif //AVNC_TEST_HOST_RFBCLIENT_H
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026  Gaurav Ujjwal.
+ *
+ * SPDX-License-Identifier:  GPL-3.0-or-later
+ *
+ * See COPYING.txt for more details.
+ */
+
+#ifndef AVNC_TEST_HOST_TURBOJPEG_H
+#define AVNC_TEST_HOST_TURBOJPEG_H
+
+/**
+ * Host stand-in for <turbojpeg.h>, without an actual JPEG decoder.
+ *
+ * Tests use a fake "JPEG" format instead: width & height as two native-endian
+ * uint16_t, followed by a single uint32_t pixel which fills the whole image.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+typedef void *tjhandle;
+
+enum TJPF { TJPF_RGB, TJPF_BGR, TJPF_RGBX, TJPF_BGRX };
+#define TJFLAG_FASTDCT 2048
+
+static inline tjhandle tjInitDecompress() { return (tjhandle) 1; }
+static inline int tjDestroy(tjhandle) { return 0; }
+static inline char *tjGetErrorStr2(tjhandle) { return (char *) "Invalid test JPEG"; }
+
+static inline int tjDecompressHeader3(tjhandle, const unsigned char *jpegBuf, unsigned long jpegSize,
+                                      int *width, int *height, int *, int *) {
+    uint16_t size[2];
+    if (jpegSize < 8)
+        return -1;
+    memcpy(size, jpegBuf, sizeof(size));
+    *width = size[0];
+    *height = size[1];
+    return 0;
+}
+
+static inline int tjDecompress2(tjhandle, const unsigned char *jpegBuf, unsigned long jpegSize,
+                                unsigned char *dstBuf, int width, int pitch, int height, int, int) {
+    uint32_t pixel;
+    if (jpegSize < 8)
+        return -1;
+    memcpy(&pixel, jpegBuf + 4, sizeof(pixel));
+    for (int y = 0; y < height; ++y) {
+        auto row = (uint32_t *) (dstBuf + (size_t) y * pitch);
+        for (int x = 0; x < width; ++x)
+            row[x] = pixel;
+    }
+    return 0;
+}
+
+#endif //AVNC_TEST_HOST_TURBOJPEG_H
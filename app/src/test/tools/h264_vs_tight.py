@@ -0,0 +1,341 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026  Gaurav Ujjwal.
+#
+# SPDX-License-Identifier:  GPL-3.0-or-later
+#
+# See COPYING.txt for more details.
+#
+
+"""
+Compares Open H.264 with Tight on the same workload.
+
+For each workload, a sequence of desktop frames is generated (deterministically,
+so every run sees the same frames) and sent through two encoders:
+
+ - Tight, modelled after LibVNCServer's encoder: damage is found on a 16x16
+   grid, rects are split at 64K pixels, and each piece is sent as solid fill,
+   mono/indexed palette + zlib, or JPEG (using quality & subsampling the server
+   maps our default image quality level to).
+ - Open H.264, with libx264 configured like VNC servers do for interactive use
+   (ultrafast, zerolatency, no B-frames, one IDR at the start).
+
+Reported for each: bytes on the wire (including RFB rect headers), client CPU
+time for decoding into a BGRX framebuffer (single thread), and PSNR of the
+resulting framebuffer against the source frames.
+
+Requires: av (bundles FFmpeg with libx264), pillow (libjpeg-turbo), numpy.
+
+Usage: h264_vs_tight.py [--frames N] [--crf N] [--quality-level N]
+"""
+
+import argparse
+import io
+import time
+import zlib
+from fractions import Fraction
+
+import av
+import numpy as np
+from PIL import Image, ImageDraw, ImageFont
+
+WIDTH, HEIGHT = 1280, 720
+FPS = 30
+BLOCK = 16
+
+# LibVNCServer's mapping from Tight quality level to JPEG quality & subsampling
+TIGHT_JPEG_QUALITY = [15, 29, 41, 42, 62, 77, 79, 86, 92, 100]
+TIGHT_JPEG_SUBSAMPLING = ['4:2:2'] * 3 + ['4:2:0'] * 3 + ['4:4:4'] * 4
+
+TIGHT_MAX_RECT_SIZE = 65536
+TIGHT_MAX_RECT_WIDTH = 2048
+TIGHT_MAX_PALETTE = 24  # More colors than this go to JPEG
+TIGHT_ZLIB_LEVEL = 6
+
+RECT_HEADER = 12  # x, y, w, h, encoding
+UPDATE_HEADER = 4  # FramebufferUpdate message
+
+
+###############################################################################
+# Workloads
+###############################################################################
+
+def fractal_texture(size, seed):
+    """Photo-like texture: smooth color noise summed over a few octaves."""
+    rng = np.random.default_rng(seed)
+    acc = np.zeros((size, size, 3), np.float32)
+    amplitude = 1.0
+    for cells in (4, 8, 16, 32, 64, 128):
+        noise = rng.random((cells, cells, 3), dtype=np.float32)
+        img = Image.fromarray((noise * 255).astype(np.uint8)).resize((size, size), Image.BICUBIC)
+        acc += np.asarray(img, np.float32) * amplitude
+        amplitude *= 0.55
+    acc -= acc.min()
+    acc *= 255 / acc.max()
+    return acc.astype(np.uint8)
+
+
+def desktop_background():
+    """Static desktop: gradient wallpaper, a panel and a couple of windows."""
+    y = np.linspace(0, 1, HEIGHT, dtype=np.float32)[:, None]
+    x = np.linspace(0, 1, WIDTH, dtype=np.float32)[None, :]
+    bg = np.stack([40 + 60 * y + 0 * x, 70 + 40 * x + 0 * y, 110 + 50 * y * x], axis=2).astype(np.uint8)
+    img = Image.fromarray(bg)
+    draw = ImageDraw.Draw(img)
+    draw.rectangle([0, 0, WIDTH, 28], fill=(235, 235, 235))
+    font = ImageFont.load_default()
+    for i, label in enumerate(['Activities', 'Files', 'Terminal', 'Browser', 'Settings']):
+        draw.text((10 + i * 110, 8), label, fill=(20, 20, 20), font=font)
+    draw.rectangle([700, 420, 1240, 690], fill=(250, 250, 250), outline=(90, 90, 90))
+    for line in range(14):
+        draw.text((712, 430 + line * 18), 'Document line %02d: lorem ipsum dolor sit amet' % line, fill=(30, 30, 30),
+                  font=font)
+    return np.asarray(img)
+
+
+def video_workload(frames):
+    """A 640x360 video window playing a slowly panning & zooming scene."""
+    base = desktop_background().copy()
+    texture = fractal_texture(1024, 1)
+    wx, wy, ww, wh = 40, 60, 640, 360
+    base[wy - 24:wy, wx:wx + ww] = (60, 60, 60)
+    for i in range(frames):
+        frame = base.copy()
+        ox, oy = 40 + 3 * i, 30 + i
+        zoom = 1.0 + 0.002 * i
+        crop = texture[oy:oy + int(wh / zoom), ox:ox + int(ww / zoom)]
+        frame[wy:wy + wh, wx:wx + ww] = np.asarray(Image.fromarray(crop).resize((ww, wh), Image.BILINEAR))
+        yield frame
+
+
+def scroll_workload(frames):
+    """A terminal window with text scrolling by two lines per frame."""
+    base = desktop_background().copy()
+    tx, ty, tw, th = 40, 60, 640, 500
+    font = ImageFont.load_default()
+    line_height = 14
+    lines = ['[%06d] worker-%d: processed batch %d in %d ms (%s)' % (
+        n, n % 7, n * 13 % 1000, n * 37 % 250, 'ok' if n % 11 else 'retry') for n in range(frames * 2 + 40)]
+    for i in range(frames):
+        term = Image.new('RGB', (tw, th), (24, 24, 24))
+        draw = ImageDraw.Draw(term)
+        first = i * 2
+        for row in range(th // line_height):
+            draw.text((6, 4 + row * line_height), lines[first + row], fill=(200, 220, 200), font=font)
+        frame = base.copy()
+        frame[ty:ty + th, tx:tx + tw] = np.asarray(term)
+        yield frame
+
+
+def typing_workload(frames):
+    """Text being typed into the document window, one character per frame."""
+    base = desktop_background().copy()
+    font = ImageFont.load_default()
+    text = 'The quick brown fox jumps over the lazy dog. ' * 8
+    img = Image.fromarray(base)
+    draw = ImageDraw.Draw(img)
+    draw.rectangle([701, 670, 1239, 689], fill=(250, 250, 250))
+    for i in range(frames):
+        col = i % 60
+        draw.text((712 + col * 8, 672), text[i % len(text)], fill=(30, 30, 30), font=font)
+        if col == 59:
+            draw.rectangle([701, 670, 1239, 689], fill=(250, 250, 250))
+        yield np.asarray(img).copy()
+
+
+WORKLOADS = {'video': video_workload, 'scroll': scroll_workload, 'typing': typing_workload}
+
+
+###############################################################################
+# Tight
+###############################################################################
+
+def damaged_rects(prev, frame):
+    """Damage as rects: changed 16x16 blocks, merged into runs per block row,
+    and runs with same extent merged across rows."""
+    if prev is None:
+        return [(0, 0, WIDTH, HEIGHT)]
+
+    bh, bw = HEIGHT // BLOCK, WIDTH // BLOCK
+    diff = (prev != frame).any(axis=2)
+    changed = diff[:bh * BLOCK, :bw * BLOCK].reshape(bh, BLOCK, bw, BLOCK).any(axis=(1, 3))
+
+    rects = []
+    open_runs = {}
+    for by in range(bh):
+        runs = []
+        bx = 0
+        while bx < bw:
+            if changed[by, bx]:
+                start = bx
+                while bx < bw and changed[by, bx]:
+                    bx += 1
+                runs.append((start, bx))
+            bx += 1
+        next_open = {}
+        for run in runs:
+            if run in open_runs:
+                next_open[run] = open_runs.pop(run)
+            else:
+                next_open[run] = by
+        for (x0, x1), y0 in open_runs.items():
+            rects.append((x0 * BLOCK, y0 * BLOCK, (x1 - x0) * BLOCK, (by - y0) * BLOCK))
+        open_runs = next_open
+    for (x0, x1), y0 in open_runs.items():
+        rects.append((x0 * BLOCK, y0 * BLOCK, (x1 - x0) * BLOCK, (bh - y0) * BLOCK))
+    return rects
+
+
+def split_rect(x, y, w, h):
+    sub_w = min(w, TIGHT_MAX_RECT_WIDTH)
+    sub_h = max(1, min(h, TIGHT_MAX_RECT_SIZE // sub_w))
+    for sy in range(y, y + h, sub_h):
+        for sx in range(x, x + w, sub_w):
+            yield sx, sy, min(sub_w, x + w - sx), min(sub_h, y + h - sy)
+
+
+def compact_length(n):
+    return 1 if n < 128 else 2 if n < 16384 else 3
+
+
+def tight_encode(pixels, quality_level):
+    """Returns (kind, payload bytes on wire, data needed for decoding)."""
+    flat = pixels.reshape(-1, 3)
+    packed = (flat[:, 0].astype(np.uint32) << 16) | (flat[:, 1].astype(np.uint32) << 8) | flat[:, 2]
+    colors, indices = np.unique(packed, return_inverse=True)
+
+    if len(colors) == 1:
+        return 'fill', 1 + 3, None
+
+    h, w = pixels.shape[:2]
+    if len(colors) <= TIGHT_MAX_PALETTE:
+        if len(colors) == 2:
+            rows = np.packbits(indices.reshape(h, w).astype(np.uint8), axis=1)
+            data = zlib.compress(rows.tobytes(), TIGHT_ZLIB_LEVEL)
+        else:
+            data = zlib.compress(indices.astype(np.uint8).tobytes(), TIGHT_ZLIB_LEVEL)
+        header = 1 + 1 + 1 + 3 * len(colors)  # control, filter, palette size, palette
+        return 'palette', header + compact_length(len(data)) + len(data), (data, colors, len(colors) == 2)
+
+    out = io.BytesIO()
+    Image.fromarray(pixels).save(out, 'JPEG', quality=TIGHT_JPEG_QUALITY[quality_level],
+                                 subsampling=TIGHT_JPEG_SUBSAMPLING[quality_level])
+    data = out.getvalue()
+    return 'jpeg', 1 + compact_length(len(data)) + len(data), data
+
+
+def tight_decode(kind, info, w, h, fb, x, y, pixels):
+    if kind == 'fill':
+        fb[y:y + h, x:x + w] = pixels[0, 0]
+    elif kind == 'palette':
+        data, colors, mono = info
+        raw = np.frombuffer(zlib.decompress(data), np.uint8)
+        if mono:
+            idx = np.unpackbits(raw.reshape(h, -1), axis=1)[:, :w]
+        else:
+            idx = raw.reshape(h, w)
+        rgb = np.stack([(colors >> 16) & 255, (colors >> 8) & 255, colors & 255], axis=1).astype(np.uint8)
+        fb[y:y + h, x:x + w] = rgb[idx]
+    else:
+        img = Image.open(io.BytesIO(info))
+        img.load()
+        fb[y:y + h, x:x + w] = np.asarray(img.convert('RGBX'))[:, :, :3]
+
+
+def run_tight(frames, quality_level):
+    total_bytes, cpu_ns = 0, 0
+    kinds = {'fill': 0, 'palette': 0, 'jpeg': 0}
+    fb = np.zeros((HEIGHT, WIDTH, 3), np.uint8)
+    psnr = []
+    prev = None
+    for frame in frames:
+        total_bytes += UPDATE_HEADER
+        for rect in damaged_rects(prev, frame):
+            for x, y, w, h in split_rect(*rect):
+                pixels = np.ascontiguousarray(frame[y:y + h, x:x + w])
+                kind, size, info = tight_encode(pixels, quality_level)
+                kinds[kind] += 1
+                total_bytes += RECT_HEADER + size
+
+                start = time.process_time_ns()
+                tight_decode(kind, info, w, h, fb, x, y, pixels)
+                cpu_ns += time.process_time_ns() - start
+        psnr.append(frame_psnr(frame, fb))
+        prev = frame
+    return total_bytes, cpu_ns, float(np.mean(psnr)), kinds
+
+
+###############################################################################
+# Open H.264
+###############################################################################
+
+def run_h264(frames, crf):
+    encoder = av.CodecContext.create('libx264', 'w')
+    encoder.width, encoder.height = WIDTH, HEIGHT
+    encoder.pix_fmt = 'yuv420p'
+    encoder.time_base = Fraction(1, FPS)
+    encoder.framerate = FPS
+    encoder.options = {'preset': 'ultrafast', 'tune': 'zerolatency', 'crf': str(crf), 'bf': '0',
+                       'g': '100000', 'profile': 'baseline'}
+
+    decoder = av.CodecContext.create('h264', 'r')
+    decoder.thread_count = 1
+
+    total_bytes, cpu_ns = 0, 0
+    psnr = []
+    for i, frame in enumerate(frames):
+        video_frame = av.VideoFrame.from_ndarray(frame, format='rgb24')
+        video_frame.pts = i
+        packets = encoder.encode(video_frame)
+        total_bytes += UPDATE_HEADER + RECT_HEADER + 8 + sum(p.size for p in packets)  # + length & flags
+
+        # Packets are decoded directly, as a stream parser would hold each
+        # frame back until the next one arrives.
+        start = time.process_time_ns()
+        decoded = None
+        for packet in packets:
+            for out in decoder.decode(av.Packet(bytes(packet))):
+                decoded = out.to_ndarray(format='bgra')
+        cpu_ns += time.process_time_ns() - start
+
+        # Every frame must come out right away, as it would from MediaCodec in low-latency mode
+        assert decoded is not None, 'Decoder held back frame %d' % i
+        psnr.append(frame_psnr(frame, decoded[:, :, 2::-1]))
+    return total_bytes, cpu_ns, float(np.mean(psnr))
+
+
+###############################################################################
+
+def frame_psnr(a, b):
+    mse = np.mean((a.astype(np.float32) - b.astype(np.float32)) ** 2)
+    return 99.0 if mse == 0 else 10 * np.log10(255 * 255 / mse)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--frames', type=int, default=150)
+    parser.add_argument('--crf', type=int, default=23)
+    parser.add_argument('--quality-level', type=int, default=5, help='Tight quality level (AVNC default: 5)')
+    parser.add_argument('--workload', choices=WORKLOADS.keys(), action='append')
+    args = parser.parse_args()
+
+    seconds = args.frames / FPS
+    print('%dx%d, %d frames @ %d fps, Tight quality level %d, H.264 CRF %d' % (
+        WIDTH, HEIGHT, args.frames, FPS, args.quality_level, args.crf))
+    print('%-8s %-6s %10s %10s %12s %8s' % ('workload', 'codec', 'MB', 'Mbit/s', 'CPU ms/frame', 'PSNR'))
+
+    for name in args.workload or WORKLOADS.keys():
+        frames = list(WORKLOADS[name](args.frames))
+
+        size, cpu, quality, kinds = run_tight(frames, args.quality_level)
+        print('%-8s %-6s %10.2f %10.2f %12.2f %8.2f   rects: %s' % (
+            name, 'tight', size / 1e6, size * 8 / seconds / 1e6, cpu / 1e6 / args.frames, quality,
+            ', '.join('%s %d' % kv for kv in kinds.items())))
+
+        size, cpu, quality = run_h264(frames, args.crf)
+        print('%-8s %-6s %10.2f %10.2f %12.2f %8.2f' % (
+            name, 'h264', size / 1e6, size * 8 / seconds / 1e6, cpu / 1e6 / args.frames, quality))
+
+
+if __name__ == '__main__':
+    main()